@@ -0,0 +1,421 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRBandwidthStore.cpp
+ * @brief Persistent (on-disk) history of network bandwidth estimates
+ ***************************************************/
+
+#include "ABRBandwidthStore.h"
+#include "ABRManager.h"
+#include <cstring>
+#include <cstddef>
+#include <chrono>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+/**
+ * @brief File magic ("ABRH")
+ */
+static const uint32_t BANDWIDTH_STORE_MAGIC = 0x48524241;
+
+/**
+ * @brief File layout version, bump on any layout change
+ */
+static const uint32_t BANDWIDTH_STORE_VERSION = 1;
+
+/**
+ * @brief Number of interface / host entries kept in the file
+ */
+static const int BANDWIDTH_STORE_ENTRIES = 64;
+
+/**
+ * @brief One copy of an entry, written as a unit
+ */
+struct ABRBandwidthStore::Slot {
+  uint32_t generation;
+  int32_t sampleCount;
+  int64_t bandwidth;
+  int64_t averageBandwidth;
+  int64_t updatedTimeMs;
+  char networkInterface[MAX_INTERFACE_NAME];
+  char cdnHost[MAX_HOST_NAME];
+  uint32_t checksum;
+  uint32_t reserved;
+};
+
+/**
+ * @brief Double buffered entry, the slot with the valid checksum and the
+ * higher generation is the current one
+ */
+struct ABRBandwidthStore::Entry {
+  Slot slots[2];
+};
+
+/**
+ * @brief Layout of the mapped file
+ */
+struct ABRBandwidthStore::FileLayout {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t reserved;
+  Entry entries[BANDWIDTH_STORE_ENTRIES];
+};
+
+const int ABRBandwidthStore::MAX_PENDING_UPDATES;
+const int ABRBandwidthStore::WRITE_INTERVAL_MS;
+
+/**
+ * @brief FNV-1a hash
+ */
+static uint32_t fnv1a(const void* data, size_t len, uint32_t hash = 2166136261u) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < len; i++) {
+    hash ^= p[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Checksum of a slot, covering every field before the checksum
+ */
+static uint32_t slotChecksum(const void* slot, size_t checksumOffset) {
+  return fnv1a(slot, checksumOffset);
+}
+
+/**
+ * @brief Copy a string into a fixed size, zero padded buffer
+ */
+static void copyName(char* dst, size_t size, const char* src) {
+  memset(dst, 0, size);
+  strncpy(dst, src, size - 1);
+}
+
+/**
+ * @brief Wall clock time in ms, the history has to survive reboots
+ */
+static long long wallClockTimeMS() {
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return (long long)t.tv_sec * 1000 + t.tv_usec / 1000;
+}
+
+/**
+ * @brief Returns the current slot of an entry, NULL if none is valid
+ */
+template <typename SlotType>
+static const SlotType* currentSlot(const SlotType* slots, size_t checksumOffset) {
+  const SlotType* current = NULL;
+  for (int i = 0; i < 2; i++) {
+    const SlotType* slot = &slots[i];
+    if (slot->generation == 0 || slot->checksum != slotChecksum(slot, checksumOffset)) {
+      continue;
+    }
+    if (current == NULL || (int32_t)(slot->generation - current->generation) > 0) {
+      current = slot;
+    }
+  }
+  return current;
+}
+
+/**
+ * @brief Constructor of ABRBandwidthStore
+ */
+ABRBandwidthStore::ABRBandwidthStore() :
+  mPendingCount(0),
+  mWriting(false),
+  mStop(false),
+  mLayout(NULL),
+  mFd(-1) {
+  memset(mPending, 0, sizeof(mPending));
+}
+
+/**
+ * @brief Destructor of ABRBandwidthStore
+ */
+ABRBandwidthStore::~ABRBandwidthStore() {
+  close();
+}
+
+/**
+ * @brief Map the history file and start the writer thread
+ */
+bool ABRBandwidthStore::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    ABRManager::logprintf("%s:%d Failed to open bandwidth history %s\n", __FUNCTION__, __LINE__, path.c_str());
+    return false;
+  }
+
+  struct stat st;
+  bool reset = (fstat(fd, &st) != 0 || st.st_size != (off_t)sizeof(FileLayout));
+  if (reset && ftruncate(fd, sizeof(FileLayout)) != 0) {
+    ABRManager::logprintf("%s:%d Failed to size bandwidth history %s\n", __FUNCTION__, __LINE__, path.c_str());
+    ::close(fd);
+    return false;
+  }
+
+  void* addr = mmap(NULL, sizeof(FileLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    ABRManager::logprintf("%s:%d Failed to map bandwidth history %s\n", __FUNCTION__, __LINE__, path.c_str());
+    ::close(fd);
+    return false;
+  }
+
+  FileLayout* layout = static_cast<FileLayout*>(addr);
+  if (reset || layout->magic != BANDWIDTH_STORE_MAGIC || layout->version != BANDWIDTH_STORE_VERSION
+    || layout->entryCount != (uint32_t)BANDWIDTH_STORE_ENTRIES) {
+    memset(layout, 0, sizeof(FileLayout));
+    layout->version = BANDWIDTH_STORE_VERSION;
+    layout->entryCount = BANDWIDTH_STORE_ENTRIES;
+    layout->magic = BANDWIDTH_STORE_MAGIC;
+    msync(layout, sizeof(FileLayout), MS_SYNC);
+  }
+
+  mFd = fd;
+  mLayout = layout;
+  mStop = false;
+  mPendingCount = 0;
+  mWriter = std::thread(&ABRBandwidthStore::writerLoop, this);
+  return true;
+}
+
+/**
+ * @brief Flush, stop the writer thread and unmap the file
+ */
+void ABRBandwidthStore::close() {
+  if (mWriter.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCond.notify_all();
+    mWriter.join();
+  }
+  if (mLayout) {
+    msync(mLayout, sizeof(FileLayout), MS_SYNC);
+    munmap(mLayout, sizeof(FileLayout));
+    mLayout = NULL;
+  }
+  if (mFd >= 0) {
+    ::close(mFd);
+    mFd = -1;
+  }
+}
+
+/**
+ * @brief Check whether a history file is mapped
+ */
+bool ABRBandwidthStore::isOpen() const {
+  return mLayout != NULL;
+}
+
+/**
+ * @brief Find the summary of an interface / host pair
+ */
+bool ABRBandwidthStore::lookup(const std::string& networkInterface, const std::string& cdnHost, Summary& summary) {
+  std::lock_guard<std::mutex> lock(mFileMutex);
+  if (!mLayout) {
+    return false;
+  }
+  char iface[MAX_INTERFACE_NAME];
+  char host[MAX_HOST_NAME];
+  copyName(iface, sizeof(iface), networkInterface.c_str());
+  copyName(host, sizeof(host), cdnHost.c_str());
+
+  Entry* entry = findEntry(iface, host, false);
+  if (!entry) {
+    return false;
+  }
+  const Slot* slot = currentSlot(entry->slots, offsetof(Slot, checksum));
+  summary.bandwidth = (long)slot->bandwidth;
+  summary.averageBandwidth = (long)slot->averageBandwidth;
+  summary.updatedTimeMs = slot->updatedTimeMs;
+  summary.sampleCount = slot->sampleCount;
+  return true;
+}
+
+/**
+ * @brief Stage a bandwidth estimate for the writer thread
+ */
+void ABRBandwidthStore::record(const std::string& networkInterface, const std::string& cdnHost, long bandwidth) {
+  if (bandwidth <= 0) {
+    return;
+  }
+  long long now = wallClockTimeMS();
+  bool dropped = false;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mWriter.joinable() || mStop) {
+      return;
+    }
+    // Coalesce with an update of the same key that is still staged
+    int idx = 0;
+    for (; idx < mPendingCount; idx++) {
+      if (strncmp(mPending[idx].networkInterface, networkInterface.c_str(), MAX_INTERFACE_NAME - 1) == 0
+        && strncmp(mPending[idx].cdnHost, cdnHost.c_str(), MAX_HOST_NAME - 1) == 0) {
+        break;
+      }
+    }
+    if (idx == mPendingCount) {
+      if (mPendingCount == MAX_PENDING_UPDATES) {
+        // Staging area full of other keys: this estimate is dropped, the
+        // staged ones are kept. The writer is woken to drain the area, so a
+        // later estimate of this key can be staged.
+        dropped = true;
+      } else {
+        mPendingCount++;
+        copyName(mPending[idx].networkInterface, MAX_INTERFACE_NAME, networkInterface.c_str());
+        copyName(mPending[idx].cdnHost, MAX_HOST_NAME, cdnHost.c_str());
+      }
+    }
+    if (!dropped) {
+      mPending[idx].valid = true;
+      mPending[idx].bandwidth = bandwidth;
+      mPending[idx].timeMs = now;
+    }
+  }
+  mCond.notify_all();
+}
+
+/**
+ * @brief Wait until every staged update is written
+ */
+void ABRBandwidthStore::flush() {
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (mWriter.joinable() && !mStop && (mPendingCount > 0 || mWriting)) {
+    mCond.notify_all();
+    mCond.wait_for(lock, std::chrono::milliseconds(10));
+  }
+}
+
+/**
+ * @brief Writer thread, applies staged updates at most once per WRITE_INTERVAL_MS
+ * unless a flush or close is requested
+ */
+void ABRBandwidthStore::writerLoop() {
+  PendingUpdate batch[MAX_PENDING_UPDATES];
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    while (!mStop && mPendingCount == 0) {
+      mCond.wait(lock);
+    }
+    int count = mPendingCount;
+    if (count == 0 && mStop) {
+      break;
+    }
+    memcpy(batch, mPending, count * sizeof(PendingUpdate));
+    mPendingCount = 0;
+    mWriting = true;
+    lock.unlock();
+
+    {
+      std::lock_guard<std::mutex> fileLock(mFileMutex);
+      for (int i = 0; i < count; i++) {
+        applyUpdate(batch[i]);
+      }
+      msync(mLayout, sizeof(FileLayout), MS_ASYNC);
+    }
+
+    lock.lock();
+    mWriting = false;
+    mCond.notify_all();
+    if (!mStop) {
+      // Rate limit the writes, flush() shortens the wait by notifying
+      mCond.wait_for(lock, std::chrono::milliseconds(WRITE_INTERVAL_MS));
+    }
+  }
+}
+
+/**
+ * @brief Fold an estimate into its entry, writing the older slot
+ */
+void ABRBandwidthStore::applyUpdate(const PendingUpdate& update) {
+  Entry* entry = findEntry(update.networkInterface, update.cdnHost, true);
+  const Slot* current = currentSlot(entry->slots, offsetof(Slot, checksum));
+
+  Slot next;
+  memset(&next, 0, sizeof(next));
+  memcpy(next.networkInterface, update.networkInterface, MAX_INTERFACE_NAME);
+  memcpy(next.cdnHost, update.cdnHost, MAX_HOST_NAME);
+  next.bandwidth = update.bandwidth;
+  next.updatedTimeMs = update.timeMs;
+  if (current) {
+    next.generation = current->generation + 1;
+    next.sampleCount = current->sampleCount + 1;
+    // Smooth with a 1/4 weight on the newest estimate
+    next.averageBandwidth = (current->averageBandwidth * 3 + update.bandwidth) / 4;
+  } else {
+    next.generation = 1;
+    next.sampleCount = 1;
+    next.averageBandwidth = update.bandwidth;
+  }
+  if (next.generation == 0) {
+    next.generation = 1;
+  }
+  next.checksum = slotChecksum(&next, offsetof(Slot, checksum));
+
+  Slot* target = (current == &entry->slots[0]) ? &entry->slots[1] : &entry->slots[0];
+  *target = next;
+}
+
+/**
+ * @brief Find the entry of an interface / host pair. With create set, a free
+ * entry or else the least recently updated one is claimed for the key.
+ */
+ABRBandwidthStore::Entry* ABRBandwidthStore::findEntry(const char* networkInterface, const char* cdnHost, bool create) {
+  uint32_t hash = fnv1a(cdnHost, strlen(cdnHost), fnv1a(networkInterface, strlen(networkInterface)));
+  int start = (int)(hash % BANDWIDTH_STORE_ENTRIES);
+  Entry* freeEntry = NULL;
+  Entry* oldestEntry = NULL;
+  long long oldestTime = 0;
+
+  for (int i = 0; i < BANDWIDTH_STORE_ENTRIES; i++) {
+    Entry* entry = &mLayout->entries[(start + i) % BANDWIDTH_STORE_ENTRIES];
+    const Slot* slot = currentSlot(entry->slots, offsetof(Slot, checksum));
+    if (!slot) {
+      if (!freeEntry) {
+        freeEntry = entry;
+      }
+      continue;
+    }
+    if (strncmp(slot->networkInterface, networkInterface, MAX_INTERFACE_NAME) == 0
+      && strncmp(slot->cdnHost, cdnHost, MAX_HOST_NAME) == 0) {
+      return entry;
+    }
+    if (!oldestEntry || slot->updatedTimeMs < oldestTime) {
+      oldestEntry = entry;
+      oldestTime = slot->updatedTimeMs;
+    }
+  }
+  if (!create) {
+    return NULL;
+  }
+  Entry* entry = freeEntry ? freeEntry : oldestEntry;
+  if (entry != freeEntry) {
+    // Evict the previous key, so that its history is not inherited
+    memset(entry, 0, sizeof(Entry));
+  }
+  return entry;
+}
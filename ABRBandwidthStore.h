@@ -0,0 +1,185 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRBandwidthStore.h
+ * @brief Persistent (on-disk) history of network bandwidth estimates
+ ***************************************************/
+
+#ifndef ABR_BANDWIDTH_STORE_H
+#define ABR_BANDWIDTH_STORE_H
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @class ABRBandwidthStore
+ * @brief Memory-mapped store of recent bandwidth summaries
+ *
+ * Summaries are keyed by network interface and CDN host, so that a player
+ * restarted after a process exit or a reboot can pick its initial profile
+ * from the last known link estimate instead of a fixed default bitrate.
+ *
+ * record() only stages the update in memory; a writer thread applies the
+ * staged updates to the mapped file. Each entry holds two slots carrying a
+ * generation and a checksum, and the writer always overwrites the older
+ * slot, so a crash during an update leaves the previous summary readable.
+ *
+ * The file is expected to be written by a single process at a time.
+ */
+class ABRBandwidthStore {
+public:
+  /**
+   * @brief Bandwidth summary of one interface / host pair
+   */
+  struct Summary {
+    /**
+     * @brief Most recent bandwidth estimate in bps
+     */
+    long bandwidth;
+
+    /**
+     * @brief Smoothed bandwidth estimate in bps
+     */
+    long averageBandwidth;
+
+    /**
+     * @brief Wall clock time of the last update in ms since epoch
+     */
+    long long updatedTimeMs;
+
+    /**
+     * @brief Number of estimates folded into the summary
+     */
+    int sampleCount;
+  };
+
+  /**
+   * @fn ABRBandwidthStore
+   */
+  ABRBandwidthStore();
+
+  /**
+   * @fn ~ABRBandwidthStore
+   */
+  ~ABRBandwidthStore();
+
+  /**
+   * @fn open
+   *
+   * @param path Path of the history file, created if it doesn't exist
+   * @return true if the file is mapped and the writer is running
+   */
+  bool open(const std::string& path);
+
+  /**
+   * @fn close
+   * @brief Flush pending updates, stop the writer and unmap the file
+   */
+  void close();
+
+  /**
+   * @fn isOpen
+   * @return true if a history file is mapped
+   */
+  bool isOpen() const;
+
+  /**
+   * @fn lookup
+   *
+   * @param networkInterface Network interface name (eg. eth0, wlan0)
+   * @param cdnHost CDN host name
+   * @param[out] summary Stored summary if found
+   * @return true if a valid summary was found
+   */
+  bool lookup(const std::string& networkInterface, const std::string& cdnHost, Summary& summary);
+
+  /**
+   * @fn record
+   * @brief Stage a bandwidth estimate, to be written by the writer thread
+   *
+   * Never waits for the writer. An estimate replaces the staged one of the
+   * same key; if MAX_PENDING_UPDATES other keys are staged, it is dropped.
+   *
+   * @param networkInterface Network interface name
+   * @param cdnHost CDN host name
+   * @param bandwidth Bandwidth estimate in bps
+   */
+  void record(const std::string& networkInterface, const std::string& cdnHost, long bandwidth);
+
+  /**
+   * @fn flush
+   * @brief Block until all staged updates are written to the file
+   */
+  void flush();
+
+  /**
+   * @brief Max length of the network interface name, including terminator
+   */
+  static const int MAX_INTERFACE_NAME = 16;
+
+  /**
+   * @brief Max length of the CDN host name, including terminator
+   */
+  static const int MAX_HOST_NAME = 64;
+
+private:
+  struct Slot;
+  struct Entry;
+  struct FileLayout;
+
+  /**
+   * @brief Update staged by record() and not yet written
+   */
+  struct PendingUpdate {
+    bool valid;
+    char networkInterface[MAX_INTERFACE_NAME];
+    char cdnHost[MAX_HOST_NAME];
+    long bandwidth;
+    long long timeMs;
+  };
+
+  ABRBandwidthStore(const ABRBandwidthStore&);
+  ABRBandwidthStore& operator=(const ABRBandwidthStore&);
+
+  void writerLoop();
+  void applyUpdate(const PendingUpdate& update);
+  Entry* findEntry(const char* networkInterface, const char* cdnHost, bool create);
+
+  /**
+   * @brief Max number of updates staged between two writer passes
+   */
+  static const int MAX_PENDING_UPDATES = 8;
+
+  /**
+   * @brief Minimum interval between two writer passes
+   */
+  static const int WRITE_INTERVAL_MS = 1000;
+
+  PendingUpdate mPending[MAX_PENDING_UPDATES];
+  int mPendingCount;
+  bool mWriting;
+  bool mStop;
+  FileLayout* mLayout;
+  int mFd;
+  std::mutex mMutex;
+  std::mutex mFileMutex;
+  std::condition_variable mCond;
+  std::thread mWriter;
+};
+#endif
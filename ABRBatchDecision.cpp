@@ -0,0 +1,283 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRBatchDecision.cpp
+ * @brief Bandwidth based ramp up/down decisions for many sessions at once
+ ***************************************************/
+
+#include "ABRBatchDecision.h"
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ABR_BATCH_X86_KERNELS 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define ABR_BATCH_NEON_KERNEL 1
+#include <arm_neon.h>
+#endif
+
+const int ABRBatchDecision::LADDER_ALIGNMENT;
+
+/**
+ * @brief Padding of the ladders, above any estimate
+ */
+static const int64_t LADDER_PADDING = INT64_MAX;
+
+typedef int (*CountFitFunc)(const int64_t* ladder, int paddedCount, int64_t bandwidth);
+
+/**
+ * @brief Number of rungs with bandwidth <= bandwidth, padding included
+ */
+static inline int countFitScalar(const int64_t* ladder, int paddedCount, int64_t bandwidth) {
+  int fit = 0;
+  for (int i = 0; i < paddedCount; i++) {
+    fit += (ladder[i] <= bandwidth);
+  }
+  return fit;
+}
+
+#if defined(ABR_BATCH_X86_KERNELS)
+__attribute__((target("sse4.2")))
+static inline int countFitSSE42(const int64_t* ladder, int paddedCount, int64_t bandwidth) {
+  __m128i bw = _mm_set1_epi64x(bandwidth);
+  int above = 0;
+  for (int i = 0; i < paddedCount; i += 2) {
+    __m128i rungs = _mm_loadu_si128((const __m128i*)(ladder + i));
+    __m128i gt = _mm_cmpgt_epi64(rungs, bw);
+    above += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(gt)));
+  }
+  return paddedCount - above;
+}
+
+__attribute__((target("avx2")))
+static inline int countFitAVX2(const int64_t* ladder, int paddedCount, int64_t bandwidth) {
+  __m256i bw = _mm256_set1_epi64x(bandwidth);
+  int above = 0;
+  for (int i = 0; i < paddedCount; i += 4) {
+    __m256i rungs = _mm256_loadu_si256((const __m256i*)(ladder + i));
+    __m256i gt = _mm256_cmpgt_epi64(rungs, bw);
+    above += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(gt)));
+  }
+  return paddedCount - above;
+}
+#endif
+
+#if defined(ABR_BATCH_NEON_KERNEL)
+static inline int countFitNEON(const int64_t* ladder, int paddedCount, int64_t bandwidth) {
+  int64x2_t bw = vdupq_n_s64(bandwidth);
+  uint64x2_t fit = vdupq_n_u64(0);
+  for (int i = 0; i < paddedCount; i += 2) {
+    int64x2_t rungs = vld1q_s64(ladder + i);
+    // all ones (-1) for each rung <= bandwidth
+    fit = vsubq_u64(fit, vcleq_s64(rungs, bw));
+  }
+  return (int)vaddvq_u64(fit);
+}
+#endif
+
+/**
+ * @brief Decision loop, instantiated once per kernel so that the comparison
+ * is inlined with the kernel instruction set
+ */
+static inline __attribute__((always_inline)) void decideSessions(CountFitFunc countFit,
+  const int64_t* ladders, const int* ladderOffsets, const int* ladderSizes, int ladderCount,
+  int count, const int* ladderIds, const int* currentRungs, const long* networkBandwidths,
+  int nwConsistencyCnt, int* upCounts, int* downCounts, int* chosenRungs) {
+  for (int i = 0; i < count; i++) {
+    int ladderId = ladderIds[i];
+    if (ladderId < 0 || ladderId >= ladderCount) {
+      chosenRungs[i] = -1;
+      continue;
+    }
+    const int64_t* ladder = ladders + ladderOffsets[ladderId];
+    int rungCount = ladderSizes[ladderId];
+    int paddedCount = (rungCount + ABRBatchDecision::LADDER_ALIGNMENT - 1) / ABRBatchDecision::LADDER_ALIGNMENT * ABRBatchDecision::LADDER_ALIGNMENT;
+    int currentRung = std::min(std::max(currentRungs[i], 0), rungCount - 1);
+    int64_t networkBandwidth = networkBandwidths[i];
+    // padding counts as fitting only for an INT64_MAX estimate
+    int fitCount = std::min(countFit(ladder, paddedCount, networkBandwidth), rungCount);
+    chosenRungs[i] = ABRBatchDecision::decideRung(currentRung, ladder[currentRung], fitCount, networkBandwidth,
+      nwConsistencyCnt, upCounts[i], downCounts[i]);
+  }
+}
+
+#define ABR_BATCH_DECIDE_ARGS const int64_t* ladders, const int* ladderOffsets, const int* ladderSizes, int ladderCount, \
+  int count, const int* ladderIds, const int* currentRungs, const long* networkBandwidths, \
+  int nwConsistencyCnt, int* upCounts, int* downCounts, int* chosenRungs
+#define ABR_BATCH_DECIDE_PARAMS ladders, ladderOffsets, ladderSizes, ladderCount, \
+  count, ladderIds, currentRungs, networkBandwidths, nwConsistencyCnt, upCounts, downCounts, chosenRungs
+
+static void decideScalar(ABR_BATCH_DECIDE_ARGS) {
+  decideSessions(countFitScalar, ABR_BATCH_DECIDE_PARAMS);
+}
+
+#if defined(ABR_BATCH_X86_KERNELS)
+__attribute__((target("sse4.2")))
+static void decideSSE42(ABR_BATCH_DECIDE_ARGS) {
+  decideSessions(countFitSSE42, ABR_BATCH_DECIDE_PARAMS);
+}
+
+__attribute__((target("avx2")))
+static void decideAVX2(ABR_BATCH_DECIDE_ARGS) {
+  decideSessions(countFitAVX2, ABR_BATCH_DECIDE_PARAMS);
+}
+#endif
+
+#if defined(ABR_BATCH_NEON_KERNEL)
+static void decideNEON(ABR_BATCH_DECIDE_ARGS) {
+  decideSessions(countFitNEON, ABR_BATCH_DECIDE_PARAMS);
+}
+#endif
+
+/**
+ * @brief Constructor of ABRBatchDecision, with the best supported kernel
+ */
+ABRBatchDecision::ABRBatchDecision() :
+  mLadders(),
+  mLadderOffset(),
+  mLadderSize(),
+  mKernel(eKERNEL_SCALAR),
+  mDecide(decideScalar) {
+  setKernel(eKERNEL_AUTO);
+}
+
+/**
+ * @brief Check the CPU supports a kernel
+ */
+bool ABRBatchDecision::isKernelSupported(Kernel kernel) {
+  switch (kernel) {
+    case eKERNEL_SCALAR:
+      return true;
+#if defined(ABR_BATCH_X86_KERNELS)
+    case eKERNEL_SSE42:
+      return __builtin_cpu_supports("sse4.2");
+    case eKERNEL_AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+#if defined(ABR_BATCH_NEON_KERNEL)
+    case eKERNEL_NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Select the comparison kernel
+ */
+bool ABRBatchDecision::setKernel(Kernel kernel) {
+  if (kernel == eKERNEL_AUTO) {
+    static const Kernel preferred[] = { eKERNEL_AVX2, eKERNEL_SSE42, eKERNEL_NEON, eKERNEL_SCALAR };
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+      if (isKernelSupported(preferred[i])) {
+        kernel = preferred[i];
+        break;
+      }
+    }
+  }
+  if (!isKernelSupported(kernel)) {
+    return false;
+  }
+  switch (kernel) {
+#if defined(ABR_BATCH_X86_KERNELS)
+    case eKERNEL_SSE42:
+      mDecide = decideSSE42;
+      break;
+    case eKERNEL_AVX2:
+      mDecide = decideAVX2;
+      break;
+#endif
+#if defined(ABR_BATCH_NEON_KERNEL)
+    case eKERNEL_NEON:
+      mDecide = decideNEON;
+      break;
+#endif
+    default:
+      mDecide = decideScalar;
+      break;
+  }
+  mKernel = kernel;
+  return true;
+}
+
+/**
+ * @brief Add an immutable ladder
+ */
+int ABRBatchDecision::addLadder(const long* bandwidths, int count) {
+  std::vector<int64_t> rungs;
+  rungs.reserve(count);
+  for (int i = 0; i < count; i++) {
+    if (bandwidths[i] > 0) {
+      rungs.push_back(bandwidths[i]);
+    }
+  }
+  std::sort(rungs.begin(), rungs.end());
+  rungs.erase(std::unique(rungs.begin(), rungs.end()), rungs.end());
+  if (rungs.empty()) {
+    return -1;
+  }
+  int size = static_cast<int>(rungs.size());
+  int paddedSize = (size + LADDER_ALIGNMENT - 1) / LADDER_ALIGNMENT * LADDER_ALIGNMENT;
+  mLadderOffset.push_back(static_cast<int>(mLadders.size()));
+  mLadderSize.push_back(size);
+  mLadders.insert(mLadders.end(), rungs.begin(), rungs.end());
+  mLadders.insert(mLadders.end(), paddedSize - size, LADDER_PADDING);
+  return static_cast<int>(mLadderOffset.size() - 1);
+}
+
+/**
+ * @brief Rung with exactly this bandwidth
+ */
+int ABRBatchDecision::getRung(int ladderId, long bandwidth) const {
+  const int64_t* ladder = &mLadders[mLadderOffset[ladderId]];
+  const int64_t* end = ladder + mLadderSize[ladderId];
+  const int64_t* it = std::lower_bound(ladder, end, (int64_t)bandwidth);
+  if (it == end || *it != bandwidth) {
+    return -1;
+  }
+  return static_cast<int>(it - ladder);
+}
+
+/**
+ * @brief Ramp up/down decision of count sessions
+ */
+void ABRBatchDecision::decide(int count, const int* ladderIds, const int* currentRungs, const long* networkBandwidths,
+  int nwConsistencyCnt, int* upCounts, int* downCounts, int* chosenRungs) const {
+  if (mLadders.empty()) {
+    std::fill(chosenRungs, chosenRungs + count, -1);
+    return;
+  }
+  mDecide(&mLadders[0], &mLadderOffset[0], &mLadderSize[0], getLadderCount(),
+    count, ladderIds, currentRungs, networkBandwidths, nwConsistencyCnt, upCounts, downCounts, chosenRungs);
+}
+
+/**
+ * @brief Ramp up/down decision of one session
+ */
+int ABRBatchDecision::decideOne(int ladderId, int currentRung, long networkBandwidth, int nwConsistencyCnt,
+  int& upCount, int& downCount) const {
+  if (ladderId < 0 || ladderId >= getLadderCount()) {
+    return -1;
+  }
+  const int64_t* ladder = &mLadders[mLadderOffset[ladderId]];
+  int rungCount = mLadderSize[ladderId];
+  currentRung = std::min(std::max(currentRung, 0), rungCount - 1);
+  int fitCount = countFitScalar(ladder, rungCount, networkBandwidth);
+  return decideRung(currentRung, ladder[currentRung], fitCount, networkBandwidth,
+    nwConsistencyCnt, upCount, downCount);
+}
@@ -0,0 +1,217 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRBatchDecision.h
+ * @brief Bandwidth based ramp up/down decisions for many sessions at once
+ ***************************************************/
+
+#ifndef ABR_BATCH_DECISION_H
+#define ABR_BATCH_DECISION_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @class ABRBatchDecision
+ * @brief Evaluates ABRManager::getProfileIndexByBitrateRampUpOrDown for
+ * arrays of sessions sharing a set of immutable ladders
+ *
+ * A ladder is the sorted list of distinct non-iframe bandwidths of a period,
+ * and a session position on it is a rung (0 is the lowest bandwidth). The
+ * decision of a session is the same as the one of ABRManager for the profile
+ * of the current rung, including the up/down consistency counters.
+ *
+ * The rung fitting the estimated bandwidth is found by comparing the estimate
+ * with every rung of the ladder, using AVX2 or SSE4.2 (selected at runtime) on
+ * x86-64, NEON on AArch64, and a scalar loop elsewhere. All kernels give the
+ * same results.
+ */
+class ABRBatchDecision {
+public:
+  /**
+   * @brief Comparison kernels
+   */
+  enum Kernel {
+    eKERNEL_AUTO,
+    eKERNEL_SCALAR,
+    eKERNEL_SSE42,
+    eKERNEL_AVX2,
+    eKERNEL_NEON
+  };
+
+  /**
+   * @brief Ladder entries are padded to a multiple of this count
+   */
+  static const int LADDER_ALIGNMENT = 8;
+
+  /**
+   * @fn ABRBatchDecision
+   */
+  ABRBatchDecision();
+
+  /**
+   * @fn addLadder
+   * @brief Add an immutable ladder. Bandwidths are sorted, duplicates and
+   * non-positive values dropped.
+   *
+   * @param bandwidths Profile bandwidths in bps
+   * @param count Number of bandwidths
+   * @return Ladder id, -1 if no bandwidth is left
+   */
+  int addLadder(const long* bandwidths, int count);
+
+  /**
+   * @fn getLadderCount
+   */
+  int getLadderCount() const { return static_cast<int>(mLadderOffset.size()); }
+
+  /**
+   * @fn getRungCount
+   * @param ladderId Ladder id
+   * @return Number of rungs of the ladder
+   */
+  int getRungCount(int ladderId) const { return mLadderSize[ladderId]; }
+
+  /**
+   * @fn getRungBandwidth
+   * @param ladderId Ladder id
+   * @param rung Rung index
+   * @return Bandwidth of the rung in bps
+   */
+  long getRungBandwidth(int ladderId, int rung) const { return (long)mLadders[mLadderOffset[ladderId] + rung]; }
+
+  /**
+   * @fn getRung
+   * @param ladderId Ladder id
+   * @param bandwidth Bandwidth in bps
+   * @return Rung with exactly this bandwidth, -1 if none
+   */
+  int getRung(int ladderId, long bandwidth) const;
+
+  /**
+   * @fn setKernel
+   * @brief Select the comparison kernel
+   *
+   * @param kernel Kernel, eKERNEL_AUTO for the best supported one
+   * @return false if the kernel is not supported on this CPU
+   */
+  bool setKernel(Kernel kernel);
+
+  /**
+   * @fn getKernel
+   * @return Kernel in use, never eKERNEL_AUTO
+   */
+  Kernel getKernel() const { return mKernel; }
+
+  /**
+   * @fn decide
+   * @brief Ramp up/down decision of count sessions
+   *
+   * @param count Number of sessions
+   * @param ladderIds Ladder of each session
+   * @param currentRungs Current rung of each session
+   * @param networkBandwidths Estimated bandwidth of each session in bps, -1 if unknown
+   * @param nwConsistencyCnt Number of consecutive one rung moves needed to switch
+   * @param[in,out] upCounts Ramp up consistency counter of each session
+   * @param[in,out] downCounts Ramp down consistency counter of each session
+   * @param[out] chosenRungs Chosen rung of each session, -1 for an invalid ladder
+   */
+  void decide(int count, const int* ladderIds, const int* currentRungs, const long* networkBandwidths,
+    int nwConsistencyCnt, int* upCounts, int* downCounts, int* chosenRungs) const;
+
+  /**
+   * @fn decideOne
+   * @brief Ramp up/down decision of one session, scalar
+   */
+  int decideOne(int ladderId, int currentRung, long networkBandwidth, int nwConsistencyCnt,
+    int& upCount, int& downCount) const;
+
+  /**
+   * @fn decideRung
+   * @brief Decision on a ladder given the number of rungs fitting the estimate
+   *
+   * @param currentRung Current rung
+   * @param currentBandwidth Bandwidth of the current rung
+   * @param fitCount Number of rungs with bandwidth <= networkBandwidth
+   * @param networkBandwidth Estimated bandwidth, -1 if unknown
+   * @param nwConsistencyCnt Number of consecutive one rung moves needed to switch
+   * @param[in,out] upCount Ramp up consistency counter
+   * @param[in,out] downCount Ramp down consistency counter
+   * @return Chosen rung
+   */
+  static int decideRung(int currentRung, int64_t currentBandwidth, int fitCount,
+    int64_t networkBandwidth, int nwConsistencyCnt, int& upCount, int& downCount) {
+    if (networkBandwidth == -1) {
+      upCount = 0;
+      downCount = 0;
+      return currentRung;
+    }
+    int desiredRung;
+    if (networkBandwidth > currentBandwidth) {
+      // fitCount > currentRung here, highest fitting rung is at or above the current one
+      desiredRung = fitCount - 1;
+      if (desiredRung - currentRung == 1) {
+        upCount++;
+        if (upCount < nwConsistencyCnt) {
+          desiredRung = currentRung;
+        } else {
+          upCount = 0;
+        }
+      } else {
+        upCount = 0;
+      }
+      downCount = 0;
+    } else {
+      if (fitCount == 0) {
+        // no rung supports this bandwidth, lowest one
+        desiredRung = 0;
+        downCount = 0;
+      } else {
+        desiredRung = fitCount - 1;
+        if (currentRung - desiredRung == 1) {
+          downCount++;
+          if (downCount < nwConsistencyCnt) {
+            desiredRung = currentRung;
+          } else {
+            downCount = 0;
+          }
+        } else {
+          downCount = 0;
+        }
+      }
+      upCount = 0;
+    }
+    return desiredRung;
+  }
+
+private:
+  typedef void (*DecideFunc)(const int64_t* ladders, const int* ladderOffsets, const int* ladderSizes, int ladderCount,
+    int count, const int* ladderIds, const int* currentRungs, const long* networkBandwidths,
+    int nwConsistencyCnt, int* upCounts, int* downCounts, int* chosenRungs);
+
+  static bool isKernelSupported(Kernel kernel);
+
+  /**
+   * @brief Ladders, each padded with INT64_MAX to LADDER_ALIGNMENT entries
+   */
+  std::vector<int64_t> mLadders;
+  std::vector<int> mLadderOffset;
+  std::vector<int> mLadderSize;
+  Kernel mKernel;
+  DecideFunc mDecide;
+};
+#endif
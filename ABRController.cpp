@@ -0,0 +1,176 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRController.cpp
+ * @brief Event driven ABR pipeline of a player session
+ ***************************************************/
+
+#include "ABRController.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor of ABRController
+ */
+ABRController::ABRController() :
+  mManager(),
+  mCallback(NULL),
+  mCallbackContext(NULL),
+  mPeriodId(),
+  mCurrentProfile(-1),
+  mBufferValue(0),
+  mFetchedDuration(0),
+  mEstimate(-1),
+  mMaxBufferCountCheck(0),
+  mBitrateData(),
+  mSamples() {
+}
+
+/**
+ * @brief Set the profile change callback
+ */
+void ABRController::setProfileChangeCallback(ProfileChangeCallback callback, void* context) {
+  mCallback = callback;
+  mCallbackContext = context;
+}
+
+/**
+ * @brief Start a session
+ */
+int ABRController::onTune(const std::string& periodId) {
+  mPeriodId = periodId;
+  mBufferValue = 0;
+  mFetchedDuration = 0;
+  mMaxBufferCountCheck = mManager.GetPlayerConfig().abrCacheLength;
+  resetBufferCounters();
+  changeProfile(mManager.getStartupProfileIndex(mPeriodId), HybridABRManager::eAAMP_BITRATE_CHANGE_BY_TUNE);
+  mManager.StartFastStart(HybridABRManager::eAAMP_BITRATE_CHANGE_BY_TUNE);
+  return mCurrentProfile;
+}
+
+/**
+ * @brief Restart the initial buffering after a seek
+ */
+void ABRController::onSeek() {
+  mBufferValue = 0;
+  mFetchedDuration = 0;
+  resetBufferCounters();
+  mManager.StartFastStart(HybridABRManager::eAAMP_BITRATE_CHANGE_BY_SEEK);
+}
+
+/**
+ * @brief Update the estimate with a fragment and decide the next profile
+ */
+void ABRController::onDownloadComplete(long bytes, long downloadTimeMs, long fragmentDurationMs,
+  HybridABRManager::CurlAbortReason abortReason) {
+  if (mCurrentProfile < 0) {
+    return;
+  }
+  long currentBandwidth = mManager.getBandwidthOfProfile(mCurrentProfile);
+  if (bytes > mManager.GetPlayerConfig().abrThresholdSize) {
+    long downloadbps = mManager.CheckAbrThresholdSize((int)bytes, (int)std::max(downloadTimeMs, 1L),
+      currentBandwidth, (int)fragmentDurationMs, abortReason);
+    mManager.UpdateABRBitrateDataBasedOnCacheLength(mBitrateData, downloadbps, false);
+  }
+  mSamples.clear();
+  mManager.UpdateABRBitrateDataBasedOnCacheLife(mBitrateData, mSamples);
+  mEstimate = mSamples.empty() ? -1 : mManager.UpdateABRBitrateDataBasedOnCacheOutlier(mSamples);
+  mEstimate = mManager.FuseTcpInfoEstimate(mEstimate);
+  mFetchedDuration += fragmentDurationMs / 1000.0;
+  mManager.ReportFragment(mCurrentProfile, fragmentDurationMs);
+  decide();
+}
+
+/**
+ * @brief Account a stall and ramp down one profile
+ */
+void ABRController::onStall(long stallDurationMs) {
+  mManager.ReportStall(stallDurationMs);
+  mBufferValue = 0;
+  resetBufferCounters();
+  if (mCurrentProfile < 0) {
+    return;
+  }
+  int lowerProfile = mManager.getRampedDownProfileIndex(mCurrentProfile, mPeriodId);
+  changeProfile(lowerProfile, HybridABRManager::eAAMP_BITRATE_CHANGE_BY_BUFFER_EMPTY);
+}
+
+/**
+ * @brief Decision pipeline of a completed fragment
+ */
+void ABRController::decide() {
+  HybridABRManager::BitrateChangeReason reason = HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR;
+  int desiredProfile = mCurrentProfile;
+  if (mManager.IsFastStartActive() &&
+    mManager.GetFastStartProfileIndex(mCurrentProfile, desiredProfile, mEstimate, mBufferValue, reason, mPeriodId)) {
+    changeProfile(desiredProfile, reason);
+    return;
+  }
+
+  HybridABRManager::AampAbrConfig config = mManager.GetPlayerConfig();
+  if (mManager.CheckProfileChange(mFetchedDuration, mCurrentProfile, mEstimate)) {
+    desiredProfile = mManager.getProfileIndexByBitrateRampUpOrDown(mCurrentProfile,
+      mManager.getBandwidthOfProfile(mCurrentProfile), mEstimate, config.abrNwConsistency, mPeriodId);
+  }
+  if (desiredProfile != mCurrentProfile) {
+    mManager.GetDesiredProfileOnBuffer(mCurrentProfile, desiredProfile, mBufferValue, config.abrMinBuffer, mPeriodId);
+    resetBufferCounters();
+  } else if (mBufferValue >= config.abrMaxBuffer) {
+    mManager.mABRLowBufferCounter = 0;
+    if (++mManager.mABRHighBufferCounter > mMaxBufferCountCheck) {
+      mManager.CheckRampupFromSteadyState(mCurrentProfile, desiredProfile, mEstimate, mBufferValue,
+        mManager.getBandwidthOfProfile(desiredProfile), reason, mMaxBufferCountCheck, mPeriodId);
+      mManager.mABRHighBufferCounter = 0;
+    }
+  } else if (mBufferValue < config.abrMinBuffer) {
+    mManager.mABRHighBufferCounter = 0;
+    mManager.mABRLowBufferCounter++;
+    mManager.CheckRampdownFromSteadyState(mCurrentProfile, desiredProfile, reason,
+      mManager.mABRLowBufferCounter, mPeriodId);
+    if (desiredProfile != mCurrentProfile) {
+      mManager.mABRLowBufferCounter = 0;
+    }
+  } else {
+    resetBufferCounters();
+  }
+  changeProfile(desiredProfile, reason);
+}
+
+/**
+ * @brief Switch to a profile, counts the switch and calls back if it changed
+ */
+void ABRController::changeProfile(int newProfileIndex, HybridABRManager::BitrateChangeReason reason) {
+  if (newProfileIndex == mCurrentProfile) {
+    return;
+  }
+  int previousProfile = mCurrentProfile;
+  if (previousProfile >= 0) {
+    // The first profile of a session is no switch
+    mManager.ReportProfileChange(previousProfile, newProfileIndex, reason);
+  }
+  mCurrentProfile = newProfileIndex;
+  if (mCallback) {
+    mCallback(mCallbackContext, previousProfile, newProfileIndex, reason);
+  }
+}
+
+/**
+ * @brief Reset the high and low buffer counters of the steady state checks
+ */
+void ABRController::resetBufferCounters() {
+  mManager.mABRHighBufferCounter = 0;
+  mManager.mABRLowBufferCounter = 0;
+}
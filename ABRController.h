@@ -0,0 +1,168 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRController.h
+ * @brief Event driven ABR pipeline of a player session
+ ***************************************************/
+
+#ifndef ABR_CONTROLLER_H
+#define ABR_CONTROLLER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "HybridABRManager.h"
+
+/**
+ * @class ABRController
+ * @brief Owns the per fragment ABR pipeline of a player session
+ *
+ * The player pushes events and is called back only when the desired profile
+ * changes. On each completed download the controller updates the bandwidth
+ * estimate (threshold size, cache length, cache life and outlier filters),
+ * then decides with, in order: the fast start phase after a tune or seek,
+ * CheckProfileChange and getProfileIndexByBitrateRampUpOrDown, the buffer
+ * check of GetDesiredProfileOnBuffer, and the steady state rampup / rampdown
+ * checks with the high and low buffer counters.
+ *
+ * Profiles and configuration are set on the manager, see getManager(). The
+ * low latency chunk sampling stays with the player. Not thread safe, events
+ * must come from one thread.
+ */
+class ABRController {
+public:
+  /**
+   * @brief Profile change callback type
+   *
+   * @param context Context given to setProfileChangeCallback
+   * @param fromProfileIndex Previous profile, -1 on the first tune
+   * @param toProfileIndex New desired profile
+   * @param reason Reason of the change
+   */
+  typedef void (*ProfileChangeCallback)(void* context, int fromProfileIndex, int toProfileIndex,
+    HybridABRManager::BitrateChangeReason reason);
+
+  /**
+   * @fn ABRController
+   */
+  ABRController();
+
+  /**
+   * @fn getManager
+   * @return The manager of the session, to add profiles and set the configuration
+   */
+  HybridABRManager& getManager() { return mManager; }
+
+  /**
+   * @fn setProfileChangeCallback
+   * @param callback Called when the desired profile changes, NULL for none
+   * @param context Argument of the callback
+   */
+  void setProfileChangeCallback(ProfileChangeCallback callback, void* context);
+
+  /**
+   * @fn onTune
+   * @brief Start a session on the startup profile and the fast start phase
+   *
+   * @param periodId Period-Id of the profiles, empty string by default
+   * @return The startup profile index
+   */
+  int onTune(const std::string& periodId = std::string());
+
+  /**
+   * @fn onSeek
+   * @brief Restart the fast start phase and the initial buffering, keeps the
+   * bandwidth estimate
+   */
+  void onSeek();
+
+  /**
+   * @fn onPeriodChange
+   * @param periodId Period-Id of the profiles used from now on
+   */
+  void onPeriodChange(const std::string& periodId) { mPeriodId = periodId; }
+
+  /**
+   * @fn onBufferLevel
+   * @param bufferValue Buffer availability in seconds, used by the next decision
+   */
+  void onBufferLevel(double bufferValue) { mBufferValue = bufferValue; }
+
+  /**
+   * @fn onDownloadComplete
+   * @brief Account a fragment of the current profile and decide the next profile
+   *
+   * @param bytes Downloaded bytes
+   * @param downloadTimeMs Download time in ms
+   * @param fragmentDurationMs Fragment duration in ms
+   * @param abortReason Reason the download was aborted, if it was
+   */
+  void onDownloadComplete(long bytes, long downloadTimeMs, long fragmentDurationMs,
+    HybridABRManager::CurlAbortReason abortReason = HybridABRManager::eCURL_ABORT_REASON_NONE);
+
+  /**
+   * @fn onTcpInfo
+   * @brief Account a tcp_info snapshot of the download socket, fused into the
+   * estimate of the next decision
+   *
+   * @param sample tcp_info snapshot
+   * @return true if the link is congested, eg. to check ShouldAbandonFragment
+   */
+  bool onTcpInfo(const HybridABRManager::TcpInfoSample& sample) { return mManager.ReportTcpInfo(sample); }
+
+  /**
+   * @fn onStall
+   * @brief Account a stall and ramp down one profile (eAAMP_BITRATE_CHANGE_BY_BUFFER_EMPTY)
+   *
+   * @param stallDurationMs Stall duration in ms
+   */
+  void onStall(long stallDurationMs);
+
+  /**
+   * @fn getCurrentProfileIndex
+   * @return Current desired profile, -1 before onTune
+   */
+  int getCurrentProfileIndex() const { return mCurrentProfile; }
+
+  /**
+   * @fn getEstimate
+   * @return Current bandwidth estimate in bps, -1 if none
+   */
+  long getEstimate() const { return mEstimate; }
+
+private:
+  void decide();
+  void changeProfile(int newProfileIndex, HybridABRManager::BitrateChangeReason reason);
+  void resetBufferCounters();
+
+  HybridABRManager mManager;
+  ProfileChangeCallback mCallback;
+  void* mCallbackContext;
+  std::string mPeriodId;
+  int mCurrentProfile;
+  double mBufferValue;
+  double mFetchedDuration;
+  long mEstimate;
+  int mMaxBufferCountCheck;
+
+  /**
+   * @brief Estimator samples, kept across fragments to reuse their storage
+   */
+  std::vector<std::pair<long long, long> > mBitrateData;
+  std::vector<long> mSamples;
+};
+#endif
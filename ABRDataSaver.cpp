@@ -0,0 +1,188 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRDataSaver.cpp
+ * @brief Bitrate cap and byte budgets of a playback session
+ ***************************************************/
+
+#include "ABRDataSaver.h"
+#include <climits>
+#include <algorithm>
+
+const int ABRDataSaver::MAX_PROFILES;
+const int ABRDataSaver::WINDOW_MINUTES;
+const long ABRDataSaver::NO_CAP = LONG_MAX;
+
+/**
+ * @brief Duration of a bucket in ms
+ */
+static const long long DATA_SAVER_BUCKET_MS = 60000;
+
+/**
+ * @brief Constructor of ABRDataSaver
+ */
+ABRDataSaver::ABRDataSaver() :
+  mEnabled(false),
+  mMetered(false),
+  mConfig(),
+  mContentRemainingMs(-1),
+  mSessionBytes(0) {
+  for (int i = 0; i < WINDOW_MINUTES; i++) {
+    mBucketBytes[i] = 0;
+    mBucketMinute[i] = -1;
+  }
+}
+
+/**
+ * @brief Enable the data saver
+ */
+void ABRDataSaver::configure(const Config& config) {
+  mConfig = config;
+  mConfig.profileCount = std::min(std::max(config.profileCount, 0), MAX_PROFILES);
+  mEnabled = true;
+}
+
+/**
+ * @brief Disable the data saver
+ */
+void ABRDataSaver::disable() {
+  mEnabled = false;
+}
+
+/**
+ * @brief Account downloaded bytes
+ */
+void ABRDataSaver::addBytes(long long bytes, long long nowMs) {
+  if (bytes <= 0) {
+    return;
+  }
+  mSessionBytes += bytes;
+  long long minute = nowMs / DATA_SAVER_BUCKET_MS;
+  int slot = (int)(minute % WINDOW_MINUTES);
+  if (mBucketMinute[slot] != minute) {
+    mBucketMinute[slot] = minute;
+    mBucketBytes[slot] = 0;
+  }
+  mBucketBytes[slot] += bytes;
+}
+
+/**
+ * @brief Bytes downloaded during a minute, 0 if it left the window
+ */
+long long ABRDataSaver::bucketBytes(long long minute) const {
+  if (minute < 0) {
+    return 0;
+  }
+  int slot = (int)(minute % WINDOW_MINUTES);
+  return mBucketMinute[slot] == minute ? mBucketBytes[slot] : 0;
+}
+
+/**
+ * @brief Bytes downloaded in the last hour
+ */
+long long ABRDataSaver::getWindowBytes(long long nowMs) const {
+  long long minute = nowMs / DATA_SAVER_BUCKET_MS;
+  long long bytes = 0;
+  for (int i = 0; i < WINDOW_MINUTES; i++) {
+    bytes += bucketBytes(minute - i);
+  }
+  return bytes;
+}
+
+/**
+ * @brief First profile matching the hour and link type
+ */
+const ABRDataSaver::Profile* ABRDataSaver::activeProfile(int hourOfDay) const {
+  for (int i = 0; i < mConfig.profileCount; i++) {
+    const Profile& profile = mConfig.profiles[i];
+    if (profile.meteredOnly && !mMetered) {
+      continue;
+    }
+    bool inHours;
+    if (profile.startHour == profile.endHour) {
+      inHours = true;
+    } else if (profile.startHour < profile.endHour) {
+      inHours = hourOfDay >= profile.startHour && hourOfDay < profile.endHour;
+    } else {
+      inHours = hourOfDay >= profile.startHour || hourOfDay < profile.endHour;
+    }
+    if (inHours) {
+      return &profile;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Highest steady bitrate keeping every rolling hour ending in the
+ * next hour within the budget
+ *
+ * The hour ending T minutes from now already holds the bytes of the last
+ * (60 - T) minutes, so the bitrate is bounded by the budget left in it over
+ * T minutes, for each T.
+ */
+long ABRDataSaver::hourlyCap(long long hourlyBudgetBytes, long long nowMs) const {
+  long long minute = nowMs / DATA_SAVER_BUCKET_MS;
+  long long windowSeconds = WINDOW_MINUTES * DATA_SAVER_BUCKET_MS / 1000;
+  long long cap = hourlyBudgetBytes * 8 / windowSeconds;
+  long long consumed = 0;
+  for (int ahead = WINDOW_MINUTES - 1; ahead >= 1; ahead--) {
+    consumed += bucketBytes(minute + ahead - (WINDOW_MINUTES - 1));
+    long long left = hourlyBudgetBytes - consumed;
+    if (left <= 0) {
+      return 0;
+    }
+    cap = std::min(cap, left * 8 * 1000 / (ahead * DATA_SAVER_BUCKET_MS));
+  }
+  return (long)std::min(cap, (long long)NO_CAP);
+}
+
+/**
+ * @brief Highest bitrate allowed now
+ */
+long ABRDataSaver::getBandwidthCap(long long nowMs, int hourOfDay) const {
+  if (!mEnabled) {
+    return NO_CAP;
+  }
+  long cap = NO_CAP;
+  const Profile* profile = activeProfile(hourOfDay);
+  if (profile) {
+    if (profile->maxBitrate > 0) {
+      cap = std::min(cap, profile->maxBitrate);
+    }
+    if (profile->hourlyBudgetBytes > 0) {
+      cap = std::min(cap, hourlyCap(profile->hourlyBudgetBytes, nowMs));
+    }
+  }
+  if (mConfig.sessionBudgetBytes > 0) {
+    long long left = mConfig.sessionBudgetBytes - mSessionBytes;
+    if (left <= 0) {
+      cap = 0;
+    } else if (mContentRemainingMs > 0) {
+      cap = (long)std::min((long long)cap, left * 8 * 1000 / mContentRemainingMs);
+    }
+  }
+  return cap;
+}
+
+/**
+ * @brief Start a new session
+ */
+void ABRDataSaver::resetSession() {
+  mSessionBytes = 0;
+  mContentRemainingMs = -1;
+}
@@ -0,0 +1,191 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRDataSaver.h
+ * @brief Bitrate cap and byte budgets of a playback session
+ ***************************************************/
+
+#ifndef ABR_DATA_SAVER_H
+#define ABR_DATA_SAVER_H
+
+/**
+ * @class ABRDataSaver
+ * @brief Turns a data saver configuration and the bytes downloaded so far
+ * into the highest bitrate the session may use now
+ *
+ * The cap is the lowest of:
+ * - the maximum bitrate of the active profile,
+ * - the steady bitrate keeping every rolling hour within the hourly budget
+ *   of the active profile, given the bytes downloaded in the last hour,
+ * - the session budget left spread over the remaining content duration.
+ *
+ * The active profile is the first one matching the hour of day and the
+ * link type (metered or not). Downloads are accounted in one minute buckets.
+ */
+class ABRDataSaver {
+public:
+  /**
+   * @brief Maximum number of profiles of a configuration
+   */
+  static const int MAX_PROFILES = 4;
+
+  /**
+   * @brief Number of one minute buckets of the rolling hour
+   */
+  static const int WINDOW_MINUTES = 60;
+
+  /**
+   * @brief Limits applying at some hours of the day, or on metered links
+   */
+  struct Profile {
+    /**
+     * @brief Local hours [startHour, endHour) the profile applies to, may
+     * wrap past midnight. Equal hours mean all day.
+     */
+    int startHour;
+    int endHour;
+
+    /**
+     * @brief Only applies on a metered link
+     */
+    bool meteredOnly;
+
+    /**
+     * @brief Maximum bitrate in bps, 0 for none
+     */
+    long maxBitrate;
+
+    /**
+     * @brief Bytes allowed in any rolling hour, 0 for none
+     */
+    long long hourlyBudgetBytes;
+  };
+
+  /**
+   * @brief Data saver configuration
+   */
+  struct Config {
+    /**
+     * @brief Bytes allowed for the whole session, 0 for none
+     */
+    long long sessionBudgetBytes;
+
+    /**
+     * @brief Number of valid entries of profiles
+     */
+    int profileCount;
+
+    /**
+     * @brief Profiles, the first matching one is active
+     */
+    Profile profiles[MAX_PROFILES];
+  };
+
+  /**
+   * @brief Cap value meaning no cap
+   */
+  static const long NO_CAP;
+
+  /**
+   * @fn ABRDataSaver
+   * @brief Disabled data saver
+   */
+  ABRDataSaver();
+
+  /**
+   * @fn configure
+   * @brief Enable the data saver, keeps the bytes accounted so far
+   */
+  void configure(const Config& config);
+
+  /**
+   * @fn disable
+   */
+  void disable();
+
+  /**
+   * @fn isEnabled
+   */
+  bool isEnabled() const { return mEnabled; }
+
+  /**
+   * @fn setMetered
+   * @param metered The session runs over a metered link
+   */
+  void setMetered(bool metered) { mMetered = metered; }
+
+  /**
+   * @fn setContentRemaining
+   * @param remainingMs Content left to play in ms, -1 if unknown (live)
+   */
+  void setContentRemaining(long long remainingMs) { mContentRemainingMs = remainingMs; }
+
+  /**
+   * @fn addBytes
+   * @brief Account downloaded bytes
+   *
+   * @param bytes Downloaded bytes
+   * @param nowMs Current time in ms
+   */
+  void addBytes(long long bytes, long long nowMs);
+
+  /**
+   * @fn getBandwidthCap
+   *
+   * @param nowMs Current time in ms
+   * @param hourOfDay Local hour of day, 0 to 23
+   * @return Highest bitrate allowed in bps, NO_CAP if none
+   */
+  long getBandwidthCap(long long nowMs, int hourOfDay) const;
+
+  /**
+   * @fn getSessionBytes
+   * @return Bytes downloaded in the session
+   */
+  long long getSessionBytes() const { return mSessionBytes; }
+
+  /**
+   * @fn getWindowBytes
+   * @param nowMs Current time in ms
+   * @return Bytes downloaded in the last hour
+   */
+  long long getWindowBytes(long long nowMs) const;
+
+  /**
+   * @fn resetSession
+   * @brief Start a new session: clears the session bytes, keeps the rolling hour
+   */
+  void resetSession();
+
+private:
+  const Profile* activeProfile(int hourOfDay) const;
+  long long bucketBytes(long long minute) const;
+  long hourlyCap(long long hourlyBudgetBytes, long long nowMs) const;
+
+  bool mEnabled;
+  bool mMetered;
+  Config mConfig;
+  long long mContentRemainingMs;
+  long long mSessionBytes;
+
+  /**
+   * @brief Bytes per minute, the bucket of minute m is at m % WINDOW_MINUTES
+   */
+  long long mBucketBytes[WINDOW_MINUTES];
+  long long mBucketMinute[WINDOW_MINUTES];
+};
+#endif
@@ -0,0 +1,164 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRFlightRecorder.cpp
+ * @brief Binary ring of ABR inputs and decisions
+ ***************************************************/
+
+#include "ABRFlightRecorder.h"
+#include <cstdio>
+#include <chrono>
+
+const uint32_t ABRFlightRecorder::DUMP_MAGIC;
+const uint32_t ABRFlightRecorder::DUMP_VERSION;
+const uint64_t ABRFlightRecorder::NS_PER_MS;
+
+/**
+ * @brief Minimum ring size
+ */
+static const int MIN_FLIGHT_RECORDER_CAPACITY = 2;
+
+/**
+ * @brief Constructor of ABRFlightRecorder, disabled
+ */
+ABRFlightRecorder::ABRFlightRecorder() :
+  mRing(),
+  mMask(0),
+  mHead(0),
+  mConfigVersion(1),
+  mClock(NULL),
+  mClockContext(NULL) {
+}
+
+/**
+ * @brief Copy constructor of ABRFlightRecorder
+ */
+ABRFlightRecorder::ABRFlightRecorder(const ABRFlightRecorder& other) :
+  mRing(other.mRing),
+  mMask(other.mMask),
+  mHead(other.mHead.load(std::memory_order_relaxed)),
+  mConfigVersion(other.mConfigVersion.load(std::memory_order_relaxed)),
+  mClock(other.mClock),
+  mClockContext(other.mClockContext) {
+}
+
+/**
+ * @brief Assignment of ABRFlightRecorder
+ */
+ABRFlightRecorder& ABRFlightRecorder::operator=(const ABRFlightRecorder& other) {
+  if (this != &other) {
+    mRing = other.mRing;
+    mMask = other.mMask;
+    mHead.store(other.mHead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mConfigVersion.store(other.mConfigVersion.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mClock = other.mClock;
+    mClockContext = other.mClockContext;
+  }
+  return *this;
+}
+
+/**
+ * @brief Allocate the ring
+ */
+void ABRFlightRecorder::enable(int capacity) {
+  uint64_t size = MIN_FLIGHT_RECORDER_CAPACITY;
+  while (size < (uint64_t)capacity) {
+    size <<= 1;
+  }
+  std::vector<Record> ring(size);
+  for (size_t i = 0; i < ring.size(); i++) {
+    ring[i].type = eRECORD_NONE;
+  }
+  mRing.swap(ring);
+  mHead.store(0, std::memory_order_relaxed);
+  mMask = size - 1;
+}
+
+/**
+ * @brief Release the ring
+ */
+void ABRFlightRecorder::disable() {
+  mMask = 0;
+  std::vector<Record>().swap(mRing);
+  mHead.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy the recorded entries, oldest first
+ */
+void ABRFlightRecorder::getRecords(std::vector<Record>& records) const {
+  records.clear();
+  if (mMask == 0) {
+    return;
+  }
+  uint64_t head = mHead.load(std::memory_order_acquire);
+  uint64_t size = mMask + 1;
+  uint64_t first = (head > size) ? (head - size) : 0;
+  records.reserve(head - first);
+  for (uint64_t seq = first; seq < head; seq++) {
+    const Record& rec = mRing[seq & mMask];
+    if (rec.type != eRECORD_NONE) {
+      records.push_back(rec);
+    }
+  }
+}
+
+/**
+ * @brief Write the recorded entries to a file
+ */
+bool ABRFlightRecorder::dump(const std::string& path) const {
+  std::vector<Record> records;
+  getRecords(records);
+
+  FILE* f = fopen(path.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  DumpHeader header;
+  header.magic = DUMP_MAGIC;
+  header.version = DUMP_VERSION;
+  header.recordSize = sizeof(Record);
+  header.recordCount = (uint32_t)records.size();
+  bool ok = (fwrite(&header, sizeof(header), 1, f) == 1);
+  if (ok && !records.empty()) {
+    ok = (fwrite(&records[0], sizeof(Record), records.size(), f) == records.size());
+  }
+  if (fclose(f) != 0) {
+    ok = false;
+  }
+  return ok;
+}
+
+/**
+ * @brief FNV-1a hash of a period-Id
+ */
+int64_t ABRFlightRecorder::hashPeriodId(const std::string& periodId) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < periodId.size(); i++) {
+    hash ^= (unsigned char)periodId[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Monotonic time in ns
+ */
+uint64_t ABRFlightRecorder::currentTimeNS() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,288 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRFlightRecorder.h
+ * @brief Binary ring of ABR inputs and decisions
+ ***************************************************/
+
+#ifndef ABR_FLIGHT_RECORDER_H
+#define ABR_FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @class ABRFlightRecorder
+ * @brief Fixed-size in-memory ring of timestamped binary records
+ *
+ * Every estimator input, every decision (arguments, result and reason) and
+ * every ladder change is recorded, so that a session can be reconstructed
+ * and replayed from a dump. Recording is a relaxed fetch_add and a 64 byte
+ * store, the ring is disabled (no storage, no cost) until enable() is called.
+ *
+ * Records are overwritten oldest first. A dump taken while another thread
+ * records may contain a partially written record.
+ */
+class ABRFlightRecorder {
+public:
+  /**
+   * @brief Record types, and the meaning of the record arguments
+   *
+   * Times and buffer levels given as double are stored in ms.
+   */
+  enum RecordType {
+    eRECORD_NONE = 0,
+    /** args: bufferlen, downloadTimeMs, currentProfilebps, fragmentDurationMs, abortReason, downloadbps */
+    eRECORD_THRESHOLD_SIZE = 1,
+    /** args: time_now, total_dl_diff, time_diff, currentTotalDownloaded, bitsPerSecond */
+    eRECORD_LL_CHUNK_SAMPLE = 2,
+    /** args: timeMs, downloadbps, lowLatencyMode, cacheSize */
+    eRECORD_CACHE_LENGTH = 3,
+    /** args: presentTimeMs, cacheSize, samplesKept */
+    eRECORD_CACHE_LIFE = 4,
+    /** args: samples, outliers, estimate */
+    eRECORD_CACHE_OUTLIER = 5,
+    /** args: currentProfileIndex, currentBandwidth, networkBandwidth, nwConsistencyCnt, periodHash; result: profile */
+    eRECORD_RAMP_UP_OR_DOWN = 6,
+    /** args: totalFetchedDurationMs, currProfileIndex, availBW; result: profile change needed */
+    eRECORD_PROFILE_CHANGE_CHECK = 7,
+    /** args: currProfileIndex, newProfileIndex, bufferValueMs, minBufferNeededMs, periodHash; result: profile */
+    eRECORD_DESIRED_ON_BUFFER = 8,
+    /** args: currProfileIndex, newProfileIndex, nwBandwidth, bufferValueMs, newBandwidth, maxBufferCountCheck; result: profile */
+    eRECORD_RAMPUP_STEADY_STATE = 9,
+    /** args: currProfileIndex, newProfileIndex, lowBufferCounter, periodHash; result: profile */
+    eRECORD_RAMPDOWN_STEADY_STATE = 10,
+    /** args: chooseMediumProfile, periodHash, defaultInitBitrate, persistedBandwidth; result: profile */
+    eRECORD_INITIAL_PROFILE = 11,
+    /** args: bandwidth, isIframeTrack, width, height, periodHash, userData; result: profile index */
+    eRECORD_ADD_PROFILE = 12,
+    /** no args */
+    eRECORD_CLEAR_PROFILES = 13,
+    /** args: cacheLife, cacheLength, skipDuration, nwConsistency, thresholdSize, (maxBuffer << 32) | minBuffer; result: cacheOutlier */
+    eRECORD_CONFIG = 14,
+    /** args: currProfileIndex, newProfileIndex */
+    eRECORD_PROFILE_CHANGE = 15,
+    /** args: networkBandwidth, quality * 1000, scored, periodHash; result: profile */
+    eRECORD_QUALITY = 16,
+    /** args: networkBandwidth, cap, sessionBytes, windowBytes */
+    eRECORD_DATA_SAVER_CAP = 17,
+    /** args: bytesSoFar, elapsedMs, expectedBytes, bufferValueMs, currProfileIndex, periodHash; result: profile to re-request, -1 to continue */
+    eRECORD_ABANDON_CHECK = 18,
+    /** args: bufferValueMs, fragmentDurationMs, nwBandwidth, profileBandwidth, delayMs, parallelFetches; result: paced */
+    eRECORD_FETCH_ADVICE = 19,
+    /** args: startupEstimate, confidence * 1000, defaultInitBitrate, persistedBandwidth, periodHash; result: profile */
+    eRECORD_STARTUP_PROFILE = 20,
+    /** args: currProfileIndex, probeBandwidth, fragmentNumber, periodHash; result: profile */
+    eRECORD_STARTUP_PROBE = 21,
+    /** args: currProfileIndex, nwBandwidth, bufferValueMs, allowedBandwidth, fragments, periodHash; result: profile */
+    eRECORD_FAST_START = 22,
+    /** args: transferId, bytes, periodBytes, activeTransfers; result: link throughput, -1 if none */
+    eRECORD_LINK_THROUGHPUT = 23,
+    /** reason: slow start; args: rate, rttUs, minRttUs, cwnd, totalRetrans, smoothed rate; result: congested */
+    eRECORD_TCP_INFO = 24,
+    eRECORD_TYPE_MAX
+  };
+
+  /**
+   * @brief Number of arguments of a record
+   */
+  static const int MAX_RECORD_ARGS = 6;
+
+  /**
+   * @brief One record, 64 bytes
+   */
+  struct Record {
+    /**
+     * @brief Time in ns of the clock set by setClock, or monotonic time
+     */
+    uint64_t timestampNs;
+
+    /**
+     * @brief RecordType
+     */
+    uint8_t type;
+
+    /**
+     * @brief Bitrate change reason, if any
+     */
+    uint8_t reason;
+
+    /**
+     * @brief Configuration version in effect when the record was written
+     */
+    uint16_t configVersion;
+
+    /**
+     * @brief Result of the recorded call
+     */
+    int32_t result;
+
+    /**
+     * @brief Arguments, see RecordType
+     */
+    int64_t args[MAX_RECORD_ARGS];
+  };
+
+  /**
+   * @brief Header of a dump file, followed by recordCount records, oldest first
+   */
+  struct DumpHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t recordCount;
+  };
+
+  /**
+   * @brief Clock function type, returns the current time in ms, same as
+   * ABRManager::ClockFuncType
+   */
+  typedef long long (*ClockFuncType)(void* context);
+
+  /**
+   * @brief Dump file magic ("ABRF")
+   */
+  static const uint32_t DUMP_MAGIC = 0x46524241;
+
+  /**
+   * @brief Dump file version
+   */
+  static const uint32_t DUMP_VERSION = 2;
+
+  /**
+   * @brief ns per ms of the clock set by setClock
+   */
+  static const uint64_t NS_PER_MS = 1000000;
+
+  /**
+   * @fn ABRFlightRecorder
+   */
+  ABRFlightRecorder();
+
+  /**
+   * @fn ABRFlightRecorder
+   * @brief Copy the recorded ring
+   */
+  ABRFlightRecorder(const ABRFlightRecorder& other);
+
+  /**
+   * @fn operator=
+   * @brief Copy the recorded ring
+   */
+  ABRFlightRecorder& operator=(const ABRFlightRecorder& other);
+
+  /**
+   * @fn enable
+   * @brief Allocate the ring, discarding any previous record. Not thread safe
+   * against record().
+   *
+   * @param capacity Number of records, rounded up to a power of two
+   */
+  void enable(int capacity);
+
+  /**
+   * @fn disable
+   * @brief Release the ring. Not thread safe against record().
+   */
+  void disable();
+
+  /**
+   * @fn isEnabled
+   */
+  bool isEnabled() const { return mMask != 0; }
+
+  /**
+   * @fn record
+   *
+   * @param type RecordType
+   * @param reason Bitrate change reason, 0 if none
+   * @param result Result of the recorded call
+   * @param a0..a5 Arguments, see RecordType
+   */
+  void record(RecordType type, int reason, int result,
+    int64_t a0 = 0, int64_t a1 = 0, int64_t a2 = 0, int64_t a3 = 0, int64_t a4 = 0, int64_t a5 = 0) {
+    if (mMask == 0) {
+      return;
+    }
+    uint64_t seq = mHead.fetch_add(1, std::memory_order_relaxed);
+    Record& rec = mRing[seq & mMask];
+    rec.timestampNs = mClock ? (uint64_t)mClock(mClockContext) * NS_PER_MS : currentTimeNS();
+    rec.type = (uint8_t)type;
+    rec.reason = (uint8_t)reason;
+    rec.configVersion = (uint16_t)mConfigVersion.load(std::memory_order_relaxed);
+    rec.result = result;
+    rec.args[0] = a0;
+    rec.args[1] = a1;
+    rec.args[2] = a2;
+    rec.args[3] = a3;
+    rec.args[4] = a4;
+    rec.args[5] = a5;
+  }
+
+  /**
+   * @fn setConfigVersion
+   * @param version Configuration version stamped on the following records
+   */
+  void setConfigVersion(unsigned version) { mConfigVersion.store(version, std::memory_order_relaxed); }
+
+  /**
+   * @fn setClock
+   * @brief Timestamp the following records with the clock of the instance,
+   * so that they line up with the times its decisions used
+   *
+   * @param clock Clock function, NULL for the monotonic clock
+   * @param context Argument of the clock function
+   */
+  void setClock(ClockFuncType clock, void* context) { mClock = clock; mClockContext = context; }
+
+  /**
+   * @fn getRecords
+   * @param[out] records Recorded entries, oldest first
+   */
+  void getRecords(std::vector<Record>& records) const;
+
+  /**
+   * @fn dump
+   *
+   * @param path File to write
+   * @return true on success
+   */
+  bool dump(const std::string& path) const;
+
+  /**
+   * @fn hashPeriodId
+   * @return 32 bit hash identifying a period-Id in the records
+   */
+  static int64_t hashPeriodId(const std::string& periodId);
+
+  /**
+   * @fn currentTimeNS
+   * @return Monotonic time in ns
+   */
+  static uint64_t currentTimeNS();
+
+private:
+  std::vector<Record> mRing;
+  uint64_t mMask;
+  std::atomic<uint64_t> mHead;
+  std::atomic<unsigned> mConfigVersion;
+  ClockFuncType mClock;
+  void* mClockContext;
+};
+#endif
@@ -0,0 +1,258 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRInstrumentation.cpp
+ * @brief CPU cost of the public ABR calls
+ ***************************************************/
+
+#include "ABRInstrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+const int ABRInstrumentation::HISTOGRAM_BUCKETS;
+
+/**
+ * @brief Names of the instrumented calls, indexed by Api
+ */
+static const char* API_NAMES[ABRInstrumentation::eAPI_MAX] = {
+  "getInitialProfileIndex",
+  "getStartupProfileIndex",
+  "getStartupProbeProfileIndex",
+  "updateProfile",
+  "getBestMatchedProfileIndexByBandWidth",
+  "getRampedDownProfileIndex",
+  "getRampedUpProfileIndex",
+  "isProfileIndexBitrateLowest",
+  "getProfileIndexByBitrateRampUpOrDown",
+  "getProfileIndexByQuality",
+  "getProfileIndexByQualityRampUpOrDown",
+  "getMaxBandwidthProfile",
+  "recordBandwidthHistory",
+  "ReadPlayerConfig",
+  "CheckAbrThresholdSize",
+  "UpdateABRBitrateDataBasedOnCacheLength",
+  "UpdateABRBitrateDataBasedOnCacheLife",
+  "UpdateABRBitrateDataBasedOnCacheOutlier",
+  "EndTransfer",
+  "ReportTcpInfo",
+  "FuseTcpInfoEstimate",
+  "GetFetchAdvice",
+  "GetFastStartProfileIndex",
+  "CheckProfileChange",
+  "GetDesiredProfileOnBuffer",
+  "CheckRampupFromSteadyState",
+  "CheckRampdownFromSteadyState",
+  "ShouldAbandonFragment",
+  "CheckLLDashABRSpeedStoreSize",
+  "ReportProfileChange",
+  "ReportFragment",
+  "ReportStall",
+};
+
+/**
+ * @brief Counters of a thread. Only the owner thread adds, the readers and
+ * reset() may run on any thread.
+ */
+struct ABRInstrumentation::ThreadStats {
+  std::atomic<unsigned long long> count[eAPI_MAX];
+  std::atomic<unsigned long long> totalNs[eAPI_MAX];
+  std::atomic<unsigned long long> maxNs[eAPI_MAX];
+  std::atomic<unsigned long long> histogram[eAPI_MAX][HISTOGRAM_BUCKETS];
+
+  ThreadStats() {
+    clear();
+  }
+
+  void clear() {
+    for (int api = 0; api < eAPI_MAX; api++) {
+      count[api].store(0, std::memory_order_relaxed);
+      totalNs[api].store(0, std::memory_order_relaxed);
+      maxNs[api].store(0, std::memory_order_relaxed);
+      for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        histogram[api][i].store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void add(int api, unsigned long long calls, unsigned long long ns, unsigned long long max,
+    const unsigned long long* buckets) {
+    count[api].fetch_add(calls, std::memory_order_relaxed);
+    totalNs[api].fetch_add(ns, std::memory_order_relaxed);
+    unsigned long long currentMax = maxNs[api].load(std::memory_order_relaxed);
+    while (max > currentMax && !maxNs[api].compare_exchange_weak(currentMax, max, std::memory_order_relaxed)) {
+    }
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+      if (buckets[i]) {
+        histogram[api][i].fetch_add(buckets[i], std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void addTo(Snapshot& snapshot) const {
+    for (int api = 0; api < eAPI_MAX; api++) {
+      ApiStats& stats = snapshot.apis[api];
+      stats.count += count[api].load(std::memory_order_relaxed);
+      stats.totalNs += totalNs[api].load(std::memory_order_relaxed);
+      stats.maxNs = std::max(stats.maxNs, maxNs[api].load(std::memory_order_relaxed));
+      for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        stats.histogram[i] += histogram[api][i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Counters of the live threads, and the sum of the exited ones
+ */
+struct ABRInstrumentation::Registry {
+  std::mutex mutex;
+  std::vector<ThreadStats*> threads;
+  ThreadStats exited;
+};
+
+/**
+ * @brief Registers the counters of a thread on its first call, folds them
+ * into the exited threads counters when it exits
+ */
+struct ABRInstrumentation::ThreadSlot {
+  ThreadStats* stats;
+
+  ThreadSlot() : stats(new ThreadStats()) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.push_back(stats);
+  }
+
+  ~ThreadSlot() {
+    Registry& reg = registry();
+    {
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.threads.erase(std::remove(reg.threads.begin(), reg.threads.end(), stats), reg.threads.end());
+      Snapshot folded = Snapshot();
+      stats->addTo(folded);
+      for (int api = 0; api < eAPI_MAX; api++) {
+        const ApiStats& apiStats = folded.apis[api];
+        reg.exited.add(api, apiStats.count, apiStats.totalNs, apiStats.maxNs, apiStats.histogram);
+      }
+    }
+    delete stats;
+  }
+};
+
+/**
+ * @brief The registry, never destroyed: threads may exit after the static
+ * destructors ran
+ */
+ABRInstrumentation::Registry& ABRInstrumentation::registry() {
+  static Registry* reg = new Registry();
+  return *reg;
+}
+
+/**
+ * @brief Counters of the calling thread
+ */
+ABRInstrumentation::ThreadStats& ABRInstrumentation::threadStats() {
+  static thread_local ThreadSlot slot;
+  return *slot.stats;
+}
+
+/**
+ * @brief Account a call to the counters of the calling thread
+ */
+void ABRInstrumentation::record(Api api, unsigned long long durationNs) {
+  if (api < 0 || api >= eAPI_MAX) {
+    return;
+  }
+  int bucket = durationNs ? 63 - __builtin_clzll(durationNs) : 0;
+  bucket = std::min(bucket, HISTOGRAM_BUCKETS - 1);
+
+  ThreadStats& stats = threadStats();
+  stats.count[api].fetch_add(1, std::memory_order_relaxed);
+  stats.totalNs[api].fetch_add(durationNs, std::memory_order_relaxed);
+  if (durationNs > stats.maxNs[api].load(std::memory_order_relaxed)) {
+    stats.maxNs[api].store(durationNs, std::memory_order_relaxed);
+  }
+  stats.histogram[api][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Merge the counters of all the threads
+ */
+void ABRInstrumentation::getSnapshot(Snapshot& snapshot) {
+  snapshot = Snapshot();
+#ifdef ABR_API_PROFILING
+  snapshot.enabled = true;
+#else
+  snapshot.enabled = false;
+#endif
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.exited.addTo(snapshot);
+  for (size_t i = 0; i < reg.threads.size(); i++) {
+    reg.threads[i]->addTo(snapshot);
+  }
+}
+
+/**
+ * @brief Zero the counters of all the threads
+ */
+void ABRInstrumentation::reset() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.exited.clear();
+  for (size_t i = 0; i < reg.threads.size(); i++) {
+    reg.threads[i]->clear();
+  }
+}
+
+/**
+ * @brief Name of a call
+ */
+const char* ABRInstrumentation::getApiName(Api api) {
+  return (api >= 0 && api < eAPI_MAX) ? API_NAMES[api] : "unknown";
+}
+
+/**
+ * @brief Upper bound of the histogram bucket holding a percentile
+ */
+unsigned long long ABRInstrumentation::getPercentileNs(const ApiStats& stats, double percentile) {
+  if (stats.count == 0) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  unsigned long long rank = (unsigned long long)(stats.count * percentile / 100.0 + 0.5);
+  rank = std::max(rank, 1ULL);
+  unsigned long long seen = 0;
+  for (int i = 0; i < HISTOGRAM_BUCKETS - 1; i++) {
+    seen += stats.histogram[i];
+    if (seen >= rank) {
+      return std::min(1ULL << (i + 1), stats.maxNs);
+    }
+  }
+  return stats.maxNs;
+}
+
+/**
+ * @brief Monotonic time in ns
+ */
+unsigned long long ABRInstrumentation::currentTimeNS() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,189 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRInstrumentation.h
+ * @brief CPU cost of the public ABR calls
+ ***************************************************/
+
+#ifndef ABR_INSTRUMENTATION_H
+#define ABR_INSTRUMENTATION_H
+
+/**
+ * @brief Time the enclosing public call, compiled out unless the library is
+ * built with ABR_API_PROFILING (cmake -DABR_ENABLE_API_PROFILING=ON)
+ */
+#ifdef ABR_API_PROFILING
+#define ABR_PROFILE_API(api) ABRInstrumentation::Scope abrApiScope(ABRInstrumentation::api)
+#else
+#define ABR_PROFILE_API(api)
+#endif
+
+/**
+ * @class ABRInstrumentation
+ * @brief Per API call counts and log2 latency histograms of the library
+ *
+ * Each instrumented call is timed with the monotonic clock, inclusive of the
+ * instrumented calls it makes. The counters are per thread, so a call only
+ * touches cache lines of its own thread, and getSnapshot() merges the
+ * threads, including the ones that exited. Process wide: the counters of
+ * every manager instance are merged.
+ *
+ * Trivial accessors (getBandwidthOfProfile, GetPlayerConfig...) are not
+ * instrumented, the clock reads would cost more than the call.
+ */
+class ABRInstrumentation {
+public:
+  /**
+   * @brief Instrumented calls
+   */
+  enum Api {
+    eAPI_GET_INITIAL_PROFILE_INDEX,
+    eAPI_GET_STARTUP_PROFILE_INDEX,
+    eAPI_GET_STARTUP_PROBE_PROFILE_INDEX,
+    eAPI_UPDATE_PROFILE,
+    eAPI_GET_BEST_MATCHED_PROFILE_INDEX,
+    eAPI_GET_RAMPED_DOWN_PROFILE_INDEX,
+    eAPI_GET_RAMPED_UP_PROFILE_INDEX,
+    eAPI_IS_PROFILE_INDEX_BITRATE_LOWEST,
+    eAPI_GET_PROFILE_INDEX_BY_BITRATE_RAMP,
+    eAPI_GET_PROFILE_INDEX_BY_QUALITY,
+    eAPI_GET_PROFILE_INDEX_BY_QUALITY_RAMP,
+    eAPI_GET_MAX_BANDWIDTH_PROFILE,
+    eAPI_RECORD_BANDWIDTH_HISTORY,
+    eAPI_READ_PLAYER_CONFIG,
+    eAPI_CHECK_ABR_THRESHOLD_SIZE,
+    eAPI_UPDATE_CACHE_LENGTH,
+    eAPI_UPDATE_CACHE_LIFE,
+    eAPI_UPDATE_CACHE_OUTLIER,
+    eAPI_END_TRANSFER,
+    eAPI_REPORT_TCP_INFO,
+    eAPI_FUSE_TCP_INFO_ESTIMATE,
+    eAPI_GET_FETCH_ADVICE,
+    eAPI_GET_FAST_START_PROFILE_INDEX,
+    eAPI_CHECK_PROFILE_CHANGE,
+    eAPI_GET_DESIRED_PROFILE_ON_BUFFER,
+    eAPI_CHECK_RAMPUP_FROM_STEADY_STATE,
+    eAPI_CHECK_RAMPDOWN_FROM_STEADY_STATE,
+    eAPI_SHOULD_ABANDON_FRAGMENT,
+    eAPI_CHECK_LL_SPEED_STORE_SIZE,
+    eAPI_REPORT_PROFILE_CHANGE,
+    eAPI_REPORT_FRAGMENT,
+    eAPI_REPORT_STALL,
+    eAPI_MAX
+  };
+
+  /**
+   * @brief Number of latency buckets. Bucket i counts the calls that took
+   * [2^i, 2^(i+1)) ns, bucket 0 also counts 0 ns and the last bucket every
+   * call of 2^(HISTOGRAM_BUCKETS-1) ns or more.
+   */
+  static const int HISTOGRAM_BUCKETS = 32;
+
+  /**
+   * @brief Counters of a call
+   */
+  struct ApiStats {
+    unsigned long long count;
+    unsigned long long totalNs;
+    unsigned long long maxNs;
+    unsigned long long histogram[HISTOGRAM_BUCKETS];
+  };
+
+  /**
+   * @brief Point in time copy of the counters
+   */
+  struct Snapshot {
+    /**
+     * @brief false if the library was built without ABR_API_PROFILING, the
+     * counters are then all 0
+     */
+    bool enabled;
+
+    ApiStats apis[eAPI_MAX];
+  };
+
+  /**
+   * @brief Times a call from construction to destruction
+   */
+  class Scope {
+  public:
+    explicit Scope(Api api) : mApi(api), mStartNs(currentTimeNS()) {}
+    ~Scope() { record(mApi, currentTimeNS() - mStartNs); }
+
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    Api mApi;
+    unsigned long long mStartNs;
+  };
+
+  /**
+   * @fn record
+   * @brief Account a call to the counters of the calling thread
+   *
+   * @param api Call
+   * @param durationNs Duration of the call in ns
+   */
+  static void record(Api api, unsigned long long durationNs);
+
+  /**
+   * @fn getSnapshot
+   * @brief Merge the counters of all the threads
+   *
+   * @param[out] snapshot Current counters
+   */
+  static void getSnapshot(Snapshot& snapshot);
+
+  /**
+   * @fn reset
+   * @brief Zero the counters of all the threads. Calls running concurrently
+   * may be lost or kept.
+   */
+  static void reset();
+
+  /**
+   * @fn getApiName
+   * @param api Call
+   * @return Name of the call, "unknown" if out of range
+   */
+  static const char* getApiName(Api api);
+
+  /**
+   * @fn getPercentileNs
+   * @param stats Counters of a call
+   * @param percentile Percentile, in [0, 100]
+   * @return Upper bound in ns of the histogram bucket holding the percentile,
+   * 0 if no call
+   */
+  static unsigned long long getPercentileNs(const ApiStats& stats, double percentile);
+
+  /**
+   * @fn currentTimeNS
+   * @return Monotonic time in ns
+   */
+  static unsigned long long currentTimeNS();
+
+private:
+  struct ThreadStats;
+  struct ThreadSlot;
+  struct Registry;
+
+  static Registry& registry();
+  static ThreadStats& threadStats();
+};
+#endif
@@ -20,10 +20,16 @@
  ***************************************************/
 
 #include "ABRManager.h"
+#include "ABRBandwidthStore.h"
+#include "ABRSharedBandwidth.h"
+#include "ABRInstrumentation.h"
 #include <cstdio>
 #include <cstdarg>
 #include <sys/time.h>
 #include <cstring>
+#include <algorithm>
+#include <ctime>
+#include <cmath>
 
 #if !(defined(WIN32) || defined(__APPLE__))
 #if defined(USE_SYSTEMD_JOURNAL_PRINT)
@@ -150,6 +156,15 @@ void ABRLogger(const char* levelstr,const char* file, int line,const char *fmt,
 #endif
 }
 
+/**
+ * @brief Wall clock time in ms, as used by the persisted bandwidth history
+ */
+static long long getWallClockTimeMS() {
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return (long long)t.tv_sec * 1000 + t.tv_usec / 1000;
+}
+
 /**
  * @brief Initialize the logger to printf
  */
@@ -159,16 +174,47 @@ ABRManager::LoggerFuncType ABRManager::logprintf = defaultLogger;
 
 long ABRManager::mPersistBandwidth = 0;
 long long ABRManager::mPersistBandwidthUpdatedTime = 0;
+
+const long long ABRManager::STARTUP_ESTIMATE_HALF_LIFE_MS;
+const int ABRManager::STARTUP_ESTIMATE_HALF_SAMPLES;
+const int ABRManager::STARTUP_PROBE_FRAGMENTS;
+
+/**
+ * @brief Part of the startup estimate / probe throughput a profile may use
+ */
+static const double STARTUP_BANDWIDTH_SAFETY = 0.9;
+
+/**
+ * @brief Period of the data saver hour of day reads, in clock ms
+ */
+static const long long MS_PER_MINUTE = 60000;
+
 /**
  * @brief Constructor of ABRManager
  */
 ABRManager::ABRManager() : 
+  mClock(NULL),
+  mClockContext(NULL),
+  mDataSaver(),
+  mHourOfDaySource(NULL),
+  mHourOfDayContext(NULL),
+  mHourOfDay(0),
+  mHourOfDayMinute(-1),
   mDefaultInitBitrate(DEFAULT_BITRATE),
   mDesiredIframeProfile(0),
   mAbrProfileChangeUpCount(0),
   mAbrProfileChangeDownCount(0),
   mLowestIframeProfile(INVALID_PROFILE),
-  mDefaultIframeBitrate(0) {
+  mSwitchHysteresisEnabled(false),
+  mSwitchHysteresis(),
+  mHysteresisState(),
+  mQualityMinGainPerMbps(0),
+  mQualityCeiling(0),
+  mDefaultIframeBitrate(0),
+  mBandwidthStore(NULL),
+  mBandwidthStoreInterface(),
+  mBandwidthStoreHost(),
+  mSharedBandwidth(NULL) {
 
 }
 
@@ -177,24 +223,61 @@ ABRManager::ABRManager() :
  * the profile whose bitrate >= the default bitrate.
  */
 int ABRManager::getInitialProfileIndex(bool chooseMediumProfile, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_INITIAL_PROFILE_INDEX);
   int profileCount = getProfileCount();
   int desiredProfileIndex = INVALID_PROFILE;
 
   if (profileCount == 0) {
     sLogger("%s:%d No profiles found\n",
        __FUNCTION__, __LINE__);
+    mFlightRecorder.record(ABRFlightRecorder::eRECORD_INITIAL_PROFILE, 0, desiredProfileIndex,
+      chooseMediumProfile, ABRFlightRecorder::hashPeriodId(periodId), mDefaultInitBitrate, 0);
     return desiredProfileIndex;
   }
 
-  if (chooseMediumProfile && profileCount > 1) {
+  // Seed from the persisted history of this interface / host, if it is recent
+  long historyBandwidth = 0;
+  if (mBandwidthStore) {
+    ABRBandwidthStore::Summary summary;
+    if (mBandwidthStore->lookup(mBandwidthStoreInterface, mBandwidthStoreHost, summary)
+      && (getWallClockTimeMS() - summary.updatedTimeMs) <= MAX_BANDWIDTH_HISTORY_AGE_MS) {
+      historyBandwidth = summary.averageBandwidth;
+      mPersistBandwidth = historyBandwidth;
+      mPersistBandwidthUpdatedTime = summary.updatedTimeMs;
+    }
+  }
+  // A running player process may have a fresher estimate of the link
+  if (mSharedBandwidth) {
+    ABRSharedBandwidth::Estimate shared;
+    if (mSharedBandwidth->read(shared) && shared.updatedTimeMs > mPersistBandwidthUpdatedTime
+      && (getWallClockTimeMS() - shared.updatedTimeMs) <= MAX_BANDWIDTH_HISTORY_AGE_MS) {
+      historyBandwidth = shared.averageBandwidth;
+      mPersistBandwidth = historyBandwidth;
+      mPersistBandwidthUpdatedTime = shared.updatedTimeMs;
+    }
+  }
+
+  if (historyBandwidth > 0) {
+    SortedBWProfileListIter iter;
+    desiredProfileIndex = getSortedLadder(periodId).begin()->second;
+    for (iter = getSortedLadder(periodId).begin(); iter != getSortedLadder(periodId).end(); ++iter) {
+      if (iter->first > historyBandwidth) {
+        break;
+      }
+      // Choose the highest profile supported by the persisted bandwidth
+      desiredProfileIndex = iter->second;
+    }
+    sLogger("%s:%d Persisted bandwidth %ld for %s/%s\n",
+      __FUNCTION__, __LINE__, historyBandwidth, mBandwidthStoreInterface.c_str(), mBandwidthStoreHost.c_str());
+  } else if (chooseMediumProfile && profileCount > 1) {
     // get the mid profile from the sorted list
-    SortedBWProfileListIter iter = mSortedBWProfileList[periodId].begin();
-    std::advance(iter, static_cast<int>(mSortedBWProfileList[periodId].size() / 2));
+    SortedBWProfileListIter iter = getSortedLadder(periodId).begin();
+    std::advance(iter, static_cast<int>(getSortedLadder(periodId).size() / 2));
     desiredProfileIndex = iter->second;
   } else {
     SortedBWProfileListIter iter;
-    desiredProfileIndex = mSortedBWProfileList[periodId].begin()->second;
-    for (iter = mSortedBWProfileList[periodId].begin(); iter != mSortedBWProfileList[periodId].end(); ++iter) {
+    desiredProfileIndex = getSortedLadder(periodId).begin()->second;
+    for (iter = getSortedLadder(periodId).begin(); iter != getSortedLadder(periodId).end(); ++iter) {
       if (iter->first > mDefaultInitBitrate) {
         break;
       }
@@ -203,12 +286,104 @@ int ABRManager::getInitialProfileIndex(bool chooseMediumProfile, const std::stri
     }
   }
   if (INVALID_PROFILE == desiredProfileIndex) {
-    desiredProfileIndex = mSortedBWProfileList[periodId].begin()->second;
+    desiredProfileIndex = getSortedLadder(periodId).begin()->second;
     sLogger("%s:%d Got invalid profile index, choose the first index = %d and profileCount = %d and defaultBitrate = %ld\n",
       __FUNCTION__, __LINE__, desiredProfileIndex, profileCount, mDefaultInitBitrate);
   } else {
     sLogger("%s:%d Get initial profile index = %d, bitrate = %ld and defaultBitrate = %ld\n",
-      __FUNCTION__, __LINE__, desiredProfileIndex, mProfiles[desiredProfileIndex].bandwidthBitsPerSecond, mDefaultInitBitrate);
+      __FUNCTION__, __LINE__, desiredProfileIndex, mProfileBandwidth[desiredProfileIndex], mDefaultInitBitrate);
+  }
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_INITIAL_PROFILE, 0, desiredProfileIndex,
+    chooseMediumProfile, ABRFlightRecorder::hashPeriodId(periodId), mDefaultInitBitrate, historyBandwidth);
+  return desiredProfileIndex;
+}
+
+/**
+ * @brief Blend the persisted bandwidth estimate with the default init bitrate
+ */
+long ABRManager::getStartupEstimate(double& confidence) {
+  long persistedBandwidth = mPersistBandwidth;
+  long long updatedTimeMs = mPersistBandwidthUpdatedTime;
+  int sampleCount = persistedBandwidth > 0 ? 1 : 0;
+  if (mBandwidthStore) {
+    ABRBandwidthStore::Summary summary;
+    if (mBandwidthStore->lookup(mBandwidthStoreInterface, mBandwidthStoreHost, summary)) {
+      persistedBandwidth = summary.averageBandwidth;
+      updatedTimeMs = summary.updatedTimeMs;
+      sampleCount = summary.sampleCount;
+    }
+  }
+  if (mSharedBandwidth) {
+    ABRSharedBandwidth::Estimate shared;
+    if (mSharedBandwidth->read(shared) && shared.updatedTimeMs > updatedTimeMs) {
+      persistedBandwidth = shared.averageBandwidth;
+      updatedTimeMs = shared.updatedTimeMs;
+      sampleCount = shared.sampleCount;
+    }
+  }
+
+  confidence = 0;
+  long long ageMs = getWallClockTimeMS() - updatedTimeMs;
+  if (persistedBandwidth > 0 && sampleCount > 0 && updatedTimeMs > 0 && ageMs <= MAX_BANDWIDTH_HISTORY_AGE_MS) {
+    double ageWeight = pow(0.5, (double)std::max(ageMs, 0LL) / STARTUP_ESTIMATE_HALF_LIFE_MS);
+    double countWeight = (double)sampleCount / (sampleCount + STARTUP_ESTIMATE_HALF_SAMPLES);
+    confidence = ageWeight * countWeight;
+  }
+  long estimate = (long)(confidence * persistedBandwidth + (1 - confidence) * mDefaultInitBitrate);
+  sLogger("%s:%d Persisted bandwidth %ld age %lld ms samples %d, confidence %.2f, startup estimate %ld\n",
+    __FUNCTION__, __LINE__, persistedBandwidth, ageMs, sampleCount, confidence, estimate);
+  return estimate;
+}
+
+/**
+ * @brief Choose the initial profile for the startup estimate
+ */
+int ABRManager::getStartupProfileIndex(const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_STARTUP_PROFILE_INDEX);
+  if (getProfileCount() == 0) {
+    sLogger("%s:%d No profiles found\n",
+       __FUNCTION__, __LINE__);
+    return INVALID_PROFILE;
+  }
+  double confidence;
+  long estimate = getStartupEstimate(confidence);
+  int desiredProfileIndex = getHighestProfileUnder((long)(estimate * STARTUP_BANDWIDTH_SAFETY), periodId);
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_STARTUP_PROFILE, 0, desiredProfileIndex,
+    estimate, (int64_t)(confidence * 1000), mDefaultInitBitrate, mPersistBandwidth, ABRFlightRecorder::hashPeriodId(periodId));
+  return desiredProfileIndex;
+}
+
+/**
+ * @brief Correct the initial profile with the throughput of the first fragments
+ */
+int ABRManager::getStartupProbeProfileIndex(int currentProfileIndex, long probeBandwidth, int fragmentNumber, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_STARTUP_PROBE_PROFILE_INDEX);
+  int desiredProfileIndex = currentProfileIndex;
+  if (fragmentNumber >= 1 && fragmentNumber <= STARTUP_PROBE_FRAGMENTS && probeBandwidth > 0 && getProfileCount() > 0) {
+    // Several steps at once, without the network consistency count: the
+    // startup guess has no history to be consistent with
+    desiredProfileIndex = getHighestProfileUnder((long)(probeBandwidth * STARTUP_BANDWIDTH_SAFETY), periodId);
+    if (desiredProfileIndex != currentProfileIndex) {
+      sLogger("%s:%d Startup probe %ld on fragment %d, profile %d -> %d\n",
+        __FUNCTION__, __LINE__, probeBandwidth, fragmentNumber, currentProfileIndex, desiredProfileIndex);
+    }
+  }
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_STARTUP_PROBE, ABRMetrics::BITRATE_CHANGE_BY_ABR, desiredProfileIndex,
+    currentProfileIndex, probeBandwidth, fragmentNumber, ABRFlightRecorder::hashPeriodId(periodId));
+  return desiredProfileIndex;
+}
+
+/**
+ * @brief Highest profile of a period under a bandwidth
+ */
+int ABRManager::getHighestProfileUnder(long bandwidth, const std::string& periodId) {
+  std::map<long,int>& ladder = getSortedLadder(periodId);
+  if (ladder.empty()) {
+    return 0;
+  }
+  int desiredProfileIndex = ladder.begin()->second;
+  for (SortedBWProfileListIter iter = ladder.begin(); iter != ladder.end() && iter->first <= bandwidth; ++iter) {
+    desiredProfileIndex = iter->second;
   }
   return desiredProfileIndex;
 }
@@ -218,25 +393,22 @@ int ABRManager::getInitialProfileIndex(bool chooseMediumProfile, const std::stri
  *    by the profile info. 
  */
 void ABRManager::updateProfile() {
-  /**
-   * @brief A temporary structure of iframe track info
-   */
-  struct IframeTrackInfo {
-    long bandwidth;
-    int idx;
-  };
-
+  ABR_PROFILE_API(eAPI_UPDATE_PROFILE);
   int profileCount = getProfileCount();
-  
-  struct IframeTrackInfo *iframeTrackInfo = new struct IframeTrackInfo[profileCount];
+
+  // Scratch kept across calls, only grows when profiles are added
+  if (mIframeTrackInfo.size() < (size_t)profileCount) {
+    mIframeTrackInfo.resize(profileCount);
+  }
+  IframeTrackInfo *iframeTrackInfo = profileCount ? &mIframeTrackInfo[0] : NULL;
   bool is4K = false;
 
   int iframeTrackIdx = -1;
   // Construct iframe track info
   for (int i = 0; i < profileCount; i++) {
-    if (mProfiles[i].isIframeTrack) {
+    if (mProfileIsIframe[i]) {
       iframeTrackIdx++;
-      iframeTrackInfo[iframeTrackIdx].bandwidth = mProfiles[i].bandwidthBitsPerSecond;
+      iframeTrackInfo[iframeTrackIdx].bandwidth = mProfileBandwidth[i];
       iframeTrackInfo[iframeTrackIdx].idx = i;
     }
   }
@@ -256,8 +428,8 @@ void ABRManager::updateProfile() {
 
     // Exist 4K video?
     int highestProfileIdx = iframeTrackInfo[iframeTrackIdx].idx;
-    if(mProfiles[highestProfileIdx].height > HEIGHT_4K
-      || mProfiles[highestProfileIdx].width > WIDTH_4K) {
+    if(mProfileCold[highestProfileIdx].height > HEIGHT_4K
+      || mProfileCold[highestProfileIdx].width > WIDTH_4K) {
       is4K = true;
     }
 
@@ -274,7 +446,7 @@ void ABRManager::updateProfile() {
       if(is4K) {
         // Get the default profile of 4k video , apply same bandwidth of video to iframe also
         int desiredProfileIndexNonIframe = getProfileCount() / 2;
-        int desiredProfileNonIframeBW = mProfiles[desiredProfileIndexNonIframe].bandwidthBitsPerSecond ;
+        int desiredProfileNonIframeBW = mProfileBandwidth[desiredProfileIndexNonIframe] ;
         mDesiredIframeProfile = mLowestIframeProfile = 0;
         for (int cnt = 0; cnt <= iframeTrackIdx; cnt++) {
           // if bandwidth matches , apply to both desired and lower ( for all speed of trick)
@@ -303,7 +475,11 @@ void ABRManager::updateProfile() {
       }
     }
   }
-  delete[] iframeTrackInfo;
+  // Create the hysteresis state of every period now, not on the first decision
+  for (std::map<std::string, std::map<long,int> >::iterator period = mSortedBWProfileList.begin(); period != mSortedBWProfileList.end(); ++period) {
+    HysteresisState& state = mHysteresisState[period->first];
+    state.direction = 0;
+  }
 
 #if defined(DEBUG_ENABLED)
   sLogger("%s:%d Update profile info, mDesiredIframeProfile = %d, mLowestIframeProfile = %d\n",
@@ -316,19 +492,22 @@ void ABRManager::updateProfile() {
  *  profile index.
  */
 int ABRManager::getBestMatchedProfileIndexByBandWidth(int bandwidth) {
+  ABR_PROFILE_API(eAPI_GET_BEST_MATCHED_PROFILE_INDEX);
   // a) Check if network bandwidth changed from starting bandwidth
   // b) Check if netwwork bandwidth is different from persisted bandwidth( needed for first time reporting)
   // find the profile for the newbandwidth
   int desiredProfileIndex = 0;
   int profileCount = getProfileCount();
+  // Hot scan, touches only the dense bandwidth and iframe flag columns
+  const long* profileBandwidth = profileCount ? &mProfileBandwidth[0] : NULL;
+  const char* profileIsIframe = profileCount ? &mProfileIsIframe[0] : NULL;
   for (int i = 0; i < profileCount; i++) {
-    const ProfileInfo& profile = mProfiles[i];
-    if (!profile.isIframeTrack) {
-        if (profile.bandwidthBitsPerSecond == bandwidth) {
+    if (!profileIsIframe[i]) {
+        if (profileBandwidth[i] == bandwidth) {
             // Good case ,most manifest url will have same bandwidth in fragment file with configured profile bandwidth
             desiredProfileIndex = i;
             break;
-        } else if (profile.bandwidthBitsPerSecond < bandwidth) {
+        } else if (profileBandwidth[i] < bandwidth) {
             // fragment file name bandwidth doesnt match the profile bandwidth, will be always less
             if((i+1) == profileCount) {
                 desiredProfileIndex = i;
@@ -342,7 +521,7 @@ int ABRManager::getBestMatchedProfileIndexByBandWidth(int bandwidth) {
 #if defined(DEBUG_ENABLED)
   sLogger("%s:%d Get best matched profile index = %d bitrate = %ld\n",
     __FUNCTION__, __LINE__, desiredProfileIndex,
-    (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfiles[desiredProfileIndex].bandwidthBitsPerSecond : 0);
+    (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfileBandwidth[desiredProfileIndex] : 0);
 #endif
   return desiredProfileIndex;
 }
@@ -351,6 +530,7 @@ int ABRManager::getBestMatchedProfileIndexByBandWidth(int bandwidth) {
  *  @brief Ramp down the profile one step to get the profile index of a lower bitrate.
  */
 int ABRManager::getRampedDownProfileIndex(int currentProfileIndex, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_RAMPED_DOWN_PROFILE_INDEX);
   // Clamp the param to avoid overflow
   int profileCount = getProfileCount();
   if (currentProfileIndex >= profileCount) {
@@ -365,14 +545,14 @@ int ABRManager::getRampedDownProfileIndex(int currentProfileIndex, const std::st
        __FUNCTION__, __LINE__);
     return desiredProfileIndex;
   }
-  long currentBandwidth = mProfiles[currentProfileIndex].bandwidthBitsPerSecond;
-  SortedBWProfileListIter iter = mSortedBWProfileList[periodId].find(currentBandwidth);
-  if (iter == mSortedBWProfileList[periodId].end()) {
+  long currentBandwidth = mProfileBandwidth[currentProfileIndex];
+  SortedBWProfileListIter iter = getSortedLadder(periodId).find(currentBandwidth);
+  if (iter == getSortedLadder(periodId).end()) {
     sLogger("%s:%d The current bitrate %ld is not in the profile list\n",
        __FUNCTION__, __LINE__, currentBandwidth);
     return desiredProfileIndex;
   }
-  if (iter == mSortedBWProfileList[periodId].begin()) {
+  if (iter == getSortedLadder(periodId).begin()) {
     desiredProfileIndex = iter->second;
   } else {
     // get the prev profile . This is sorted list , so no worry of getting wrong profile 
@@ -382,7 +562,7 @@ int ABRManager::getRampedDownProfileIndex(int currentProfileIndex, const std::st
 
 #if defined(DEBUG_ENABLED)
   sLogger("%s:%d Ramped down profile index = %d bitrate = %ld\n",
-    __FUNCTION__, __LINE__, desiredProfileIndex, mProfiles[desiredProfileIndex].bandwidthBitsPerSecond);
+    __FUNCTION__, __LINE__, desiredProfileIndex, mProfileBandwidth[desiredProfileIndex]);
 #endif
   return desiredProfileIndex;
 }
@@ -391,6 +571,7 @@ int ABRManager::getRampedDownProfileIndex(int currentProfileIndex, const std::st
  *  @brief Ramp Up the profile one step to get the profile index of a upper bitrate.
  */
 int ABRManager::getRampedUpProfileIndex(int currentProfileIndex, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_RAMPED_UP_PROFILE_INDEX);
   // Clamp the param to avoid overflow
   int profileCount = getProfileCount();
   int desiredProfileIndex = currentProfileIndex;
@@ -401,15 +582,15 @@ int ABRManager::getRampedUpProfileIndex(int currentProfileIndex, const std::stri
 	return desiredProfileIndex;
   }
   
-  long currentBandwidth = mProfiles[currentProfileIndex].bandwidthBitsPerSecond;
-  SortedBWProfileListIter iter = mSortedBWProfileList[periodId].find(currentBandwidth);
-  if (iter == mSortedBWProfileList[periodId].end()) {
+  long currentBandwidth = mProfileBandwidth[currentProfileIndex];
+  SortedBWProfileListIter iter = getSortedLadder(periodId).find(currentBandwidth);
+  if (iter == getSortedLadder(periodId).end()) {
     sLogger("%s:%d The current bitrate %ld is not in the profile list\n",
        __FUNCTION__, __LINE__, currentBandwidth);
     return desiredProfileIndex;
   }
 
-  if(std::next(iter) != mSortedBWProfileList[periodId].end())
+  if(std::next(iter) != getSortedLadder(periodId).end())
   {
 	std::advance(iter, 1);
 	desiredProfileIndex = iter->second;
@@ -417,7 +598,7 @@ int ABRManager::getRampedUpProfileIndex(int currentProfileIndex, const std::stri
 
 #if defined(DEBUG_ENABLED)
   sLogger("%s:%d Ramped up profile index = %d bitrate = %ld\n",
-    __FUNCTION__, __LINE__, desiredProfileIndex, mProfiles[desiredProfileIndex].bandwidthBitsPerSecond);
+    __FUNCTION__, __LINE__, desiredProfileIndex, mProfileBandwidth[desiredProfileIndex]);
 #endif
   return desiredProfileIndex;
 }
@@ -436,7 +617,7 @@ int ABRManager::getUserDataOfProfile(int currentProfileIndex)
 	}
 	else
 	{
-		userData = mProfiles[currentProfileIndex].userData;
+		userData = mProfileCold[currentProfileIndex].userData;
 	}
 	return userData;
 }
@@ -446,6 +627,7 @@ int ABRManager::getUserDataOfProfile(int currentProfileIndex)
  *  @brief Check if the bitrate of currentProfileIndex reaches to the lowest.
  */
 bool ABRManager::isProfileIndexBitrateLowest(int currentProfileIndex, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_IS_PROFILE_INDEX_BITRATE_LOWEST);
   // Clamp the param to avoid overflow
   int profileCount = getProfileCount();
   if (currentProfileIndex >= profileCount) {
@@ -462,9 +644,9 @@ bool ABRManager::isProfileIndexBitrateLowest(int currentProfileIndex, const std:
     return true;
   }
 
-  long currentBandwidth = mProfiles[currentProfileIndex].bandwidthBitsPerSecond;
-  SortedBWProfileListIter iter = mSortedBWProfileList[periodId].find(currentBandwidth);
-  return iter == mSortedBWProfileList[periodId].begin();
+  long currentBandwidth = mProfileBandwidth[currentProfileIndex];
+  SortedBWProfileListIter iter = getSortedLadder(periodId).find(currentBandwidth);
+  return iter == getSortedLadder(periodId).begin();
 }
 
 /**
@@ -473,6 +655,7 @@ bool ABRManager::isProfileIndexBitrateLowest(int currentProfileIndex, const std:
  *         the current bitrate.
  */
 int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, long currentBandwidth, long networkBandwidth, int nwConsistencyCnt, const std::string& periodId) {
+  ABR_PROFILE_API(eAPI_GET_PROFILE_INDEX_BY_BITRATE_RAMP);
   // Clamp the param to avoid overflow
   int profileCount = getProfileCount();
   if (currentProfileIndex >= profileCount) {
@@ -489,14 +672,30 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
 #endif
     mAbrProfileChangeUpCount = 0;
     mAbrProfileChangeDownCount = 0;
+    mFlightRecorder.record(ABRFlightRecorder::eRECORD_RAMP_UP_OR_DOWN, ABRMetrics::BITRATE_CHANGE_BY_ABR, desiredProfileIndex,
+      currentProfileIndex, currentBandwidth, networkBandwidth, nwConsistencyCnt, ABRFlightRecorder::hashPeriodId(periodId));
     return desiredProfileIndex;
   }
-  if(networkBandwidth > currentBandwidth) {
+  long dataSaverCap = getDataSaverBandwidthCap();
+  if (networkBandwidth > dataSaverCap) {
+    // Seen as the available bandwidth, so the sorted ladder walk below
+    // picks the best profile within the budgets
+    mFlightRecorder.record(ABRFlightRecorder::eRECORD_DATA_SAVER_CAP, 0, 0,
+      networkBandwidth, dataSaverCap, mDataSaver.getSessionBytes(), mDataSaver.getWindowBytes(getCurrentTimeMS()));
+    networkBandwidth = dataSaverCap;
+  }
+  if (mSwitchHysteresisEnabled) {
+    desiredProfileIndex = getProfileIndexByHysteresis(currentProfileIndex, currentBandwidth, networkBandwidth, periodId);
+  } else if (getSortedLadder(periodId).empty()) {
+    // No profile of this period (yet), the walks below need one
+    mAbrProfileChangeUpCount = 0;
+    mAbrProfileChangeDownCount = 0;
+  } else if(networkBandwidth > currentBandwidth) {
     // if networkBandwidth > is more than current bandwidth
     SortedBWProfileListIter iter;
-    SortedBWProfileListIter currIter = mSortedBWProfileList[periodId].find(currentBandwidth);
-    SortedBWProfileListIter storedIter = mSortedBWProfileList[periodId].end();
-    for (iter = currIter; iter != mSortedBWProfileList[periodId].end(); ++iter) {
+    SortedBWProfileListIter currIter = getSortedLadder(periodId).find(currentBandwidth);
+    SortedBWProfileListIter storedIter = getSortedLadder(periodId).end();
+    for (iter = currIter; iter != getSortedLadder(periodId).end(); ++iter) {
       // This is sort List 
       if (networkBandwidth >= iter->first) {
         desiredProfileIndex = iter->second;
@@ -507,7 +706,7 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
     }
 
     // No need to jump one profile for one network bw increase
-    if (storedIter != mSortedBWProfileList[periodId].end() && (currIter->first < storedIter->first) && std::distance(currIter, storedIter) == 1) {
+    if (storedIter != getSortedLadder(periodId).end() && (currIter->first < storedIter->first) && std::distance(currIter, storedIter) == 1) {
       mAbrProfileChangeUpCount++;
       // if same profile holds good for next 3*2 fragments
       if (mAbrProfileChangeUpCount < nwConsistencyCnt) {
@@ -522,14 +721,14 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
 #if defined(DEBUG_ENABLED)
     sLogger("%s:%d Ramp up profile index = %d, bitrate = %ld networkBandwidth = %ld\n",
       __FUNCTION__, __LINE__, desiredProfileIndex,
-        (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfiles[desiredProfileIndex].bandwidthBitsPerSecond : 0, networkBandwidth);
+        (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfileBandwidth[desiredProfileIndex] : 0, networkBandwidth);
 #endif
   } else {
     // if networkBandwidth < than current bandwidth
     SortedBWProfileListRevIter reviter;
-    SortedBWProfileListIter currIter = mSortedBWProfileList[periodId].find(currentBandwidth);
-    SortedBWProfileListIter storedIter = mSortedBWProfileList[periodId].end();
-    for (reviter = mSortedBWProfileList[periodId].rbegin(); reviter != mSortedBWProfileList[periodId].rend(); ++reviter) {
+    SortedBWProfileListIter currIter = getSortedLadder(periodId).find(currentBandwidth);
+    SortedBWProfileListIter storedIter = getSortedLadder(periodId).end();
+    for (reviter = getSortedLadder(periodId).rbegin(); reviter != getSortedLadder(periodId).rend(); ++reviter) {
       // This is sorted List
       if (networkBandwidth >= reviter->first) {
         desiredProfileIndex = reviter->second;
@@ -541,13 +740,13 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
     }
 
     // we didn't find a profile which can be supported in this bandwidth
-    if (reviter == mSortedBWProfileList[periodId].rend()) {
-	desiredProfileIndex = mSortedBWProfileList[periodId].begin()->second;
-        sLogger("%s:%d Didn't find a profile which supports bandwidth[%ld], min bandwidth available [%ld]. Set profile to lowest!\n", __FUNCTION__, __LINE__, networkBandwidth, mSortedBWProfileList[periodId].begin()->first);
+    if (reviter == getSortedLadder(periodId).rend()) {
+	desiredProfileIndex = getSortedLadder(periodId).begin()->second;
+        sLogger("%s:%d Didn't find a profile which supports bandwidth[%ld], min bandwidth available [%ld]. Set profile to lowest!\n", __FUNCTION__, __LINE__, networkBandwidth, getSortedLadder(periodId).begin()->first);
     }
 
     // No need to jump one profile for small  network change
-    if (storedIter != mSortedBWProfileList[periodId].end() && (currIter->first > storedIter->first) && std::distance(storedIter, currIter) == 1) {
+    if (storedIter != getSortedLadder(periodId).end() && (currIter->first > storedIter->first) && std::distance(storedIter, currIter) == 1) {
       mAbrProfileChangeDownCount++;
       // if same profile holds good for next 3*2 fragments
       if(mAbrProfileChangeDownCount < nwConsistencyCnt) {
@@ -562,7 +761,7 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
 #if defined(DEBUG_ENABLED)
     sLogger("%s:%d Ramp down profile index = %d, bitrate = %ld networkBandwidth = %ld\n",
       __FUNCTION__, __LINE__, desiredProfileIndex,
-      (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfiles[desiredProfileIndex].bandwidthBitsPerSecond : 0, networkBandwidth);
+      (profileCount > desiredProfileIndex && desiredProfileIndex != INVALID_PROFILE) ? mProfileBandwidth[desiredProfileIndex] : 0, networkBandwidth);
 #endif
   }
 
@@ -571,6 +770,8 @@ int ABRManager::getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, lo
       __FUNCTION__, __LINE__, currentBandwidth, networkBandwidth,
       currentProfileIndex, desiredProfileIndex, periodId.c_str());
   }
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_RAMP_UP_OR_DOWN, ABRMetrics::BITRATE_CHANGE_BY_ABR, desiredProfileIndex,
+    currentProfileIndex, currentBandwidth, networkBandwidth, nwConsistencyCnt, ABRFlightRecorder::hashPeriodId(periodId));
 
   return desiredProfileIndex;
 }
@@ -592,7 +793,7 @@ long ABRManager::getBandwidthOfProfile(int profileIndex) {
     profileIndex = profileCount - 1;
   }
 
-  return mProfiles[profileIndex].bandwidthBitsPerSecond;
+  return mProfileBandwidth[profileIndex];
 }
 
 /**
@@ -600,6 +801,7 @@ long ABRManager::getBandwidthOfProfile(int profileIndex) {
  */
 int ABRManager::getMaxBandwidthProfile(const std::string& periodId)
 {
+  ABR_PROFILE_API(eAPI_GET_MAX_BANDWIDTH_PROFILE);
   int profileCount = getProfileCount();
   if (profileCount == 0) {
     sLogger("%s:%d No profiles\n",
@@ -607,7 +809,279 @@ int ABRManager::getMaxBandwidthProfile(const std::string& periodId)
     return 0;
   }
 
-  return mSortedBWProfileList[periodId].size()?mSortedBWProfileList[periodId].rbegin()->second:0;
+  return getSortedLadder(periodId).size()?getSortedLadder(periodId).rbegin()->second:0;
+}
+
+/**
+ *  @brief Pick the profile of highest quality under the network bandwidth,
+ *  with a diminishing returns cutoff
+ */
+int ABRManager::getProfileIndexByQuality(long networkBandwidth, const std::string& periodId)
+{
+  ABR_PROFILE_API(eAPI_GET_PROFILE_INDEX_BY_QUALITY);
+  std::map<std::string, std::map<long,int>>::iterator period = mSortedBWProfileList.find(periodId);
+  if (period == mSortedBWProfileList.end() || period->second.empty()) {
+    sLogger("%s:%d No profiles\n",
+      __FUNCTION__, __LINE__);
+    return 0;
+  }
+  std::map<long,int>& ladder = period->second;
+
+  // Quality is only compared when every profile of the period has a score
+  bool scored = true;
+  for (SortedBWProfileListIter iter = ladder.begin(); iter != ladder.end(); ++iter) {
+    if (mProfileQuality[iter->second] <= 0) {
+      scored = false;
+      break;
+    }
+  }
+
+  int desiredProfileIndex = ladder.begin()->second;
+  long desiredBandwidth = ladder.begin()->first;
+  for (SortedBWProfileListIter iter = std::next(ladder.begin()); iter != ladder.end() && iter->first <= networkBandwidth; ++iter) {
+    if (scored) {
+      double desiredQuality = mProfileQuality[desiredProfileIndex];
+      if (mQualityCeiling > 0 && desiredQuality >= mQualityCeiling) {
+        break;
+      }
+      // Compared with the picked profile, not the previous one, so that a
+      // step too small on its own may still be taken with the next one
+      double gain = mProfileQuality[iter->second] - desiredQuality;
+      double extraMbps = (double)(iter->first - desiredBandwidth) / 1000000;
+      if (gain <= 0 || gain < mQualityMinGainPerMbps * extraMbps) {
+        continue;
+      }
+    }
+    desiredProfileIndex = iter->second;
+    desiredBandwidth = iter->first;
+  }
+
+#if defined(DEBUG_ENABLED)
+  sLogger("%s:%d Quality profile index = %d, bitrate = %ld quality = %f networkBandwidth = %ld\n",
+    __FUNCTION__, __LINE__, desiredProfileIndex, desiredBandwidth, mProfileQuality[desiredProfileIndex], networkBandwidth);
+#endif
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_QUALITY, 0, desiredProfileIndex,
+    networkBandwidth, (int64_t)(mProfileQuality[desiredProfileIndex] * 1000), scored,
+    ABRFlightRecorder::hashPeriodId(periodId));
+  return desiredProfileIndex;
+}
+
+/**
+ *  @brief Ramp up/down as getProfileIndexByBitrateRampUpOrDown, up to the
+ *  profile picked by quality
+ */
+int ABRManager::getProfileIndexByQualityRampUpOrDown(int currentProfileIndex, long currentBandwidth, long networkBandwidth, int nwConsistencyCnt, const std::string& periodId)
+{
+  ABR_PROFILE_API(eAPI_GET_PROFILE_INDEX_BY_QUALITY_RAMP);
+  if (networkBandwidth != -1) {
+    int qualityProfileIndex = getProfileIndexByQuality(networkBandwidth, periodId);
+    long qualityBandwidth = getBandwidthOfProfile(qualityProfileIndex);
+    // Seen as the available bandwidth: no ramp up past the quality pick,
+    // no ramp down to it while the network holds the current profile
+    networkBandwidth = std::min(networkBandwidth, std::max(qualityBandwidth, currentBandwidth));
+  }
+  return getProfileIndexByBitrateRampUpOrDown(currentProfileIndex, currentBandwidth, networkBandwidth, nwConsistencyCnt, periodId);
+}
+
+/**
+ *  @brief Ramp up/down with the time-based hysteresis: one step switches
+ *  happen once they stayed wanted for the hold time of their direction,
+ *  bigger ones at once, as with the network consistency count
+ */
+int ABRManager::getProfileIndexByHysteresis(int currentProfileIndex, long currentBandwidth, long networkBandwidth, const std::string& periodId)
+{
+  std::map<long,int>& ladder = getSortedLadder(periodId);
+  std::map<std::string, HysteresisState>::iterator stateIter = mHysteresisState.find(periodId);
+  SortedBWProfileListIter currIter = ladder.find(currentBandwidth);
+  if (currIter == ladder.end()) {
+    // Not a profile of this period, eg. on a period change: nothing to debounce
+    if (stateIter != mHysteresisState.end()) {
+      stateIter->second.direction = 0;
+    }
+    return ladder.empty() ? currentProfileIndex : getHighestProfileUnder(networkBandwidth, periodId);
+  }
+  if (stateIter == mHysteresisState.end()) {
+    // Profiles added without updateProfile, the only allocating case
+    HysteresisState initial = { 0, 0 };
+    stateIter = mHysteresisState.insert(std::make_pair(periodId, initial)).first;
+  }
+  HysteresisState& state = stateIter->second;
+
+  SortedBWProfileListIter targetIter = currIter;
+  if (networkBandwidth > currentBandwidth) {
+    for (SortedBWProfileListIter iter = std::next(currIter); iter != ladder.end() && iter->first * (1 + mSwitchHysteresis.upMargin) <= networkBandwidth; ++iter) {
+      targetIter = iter;
+    }
+  } else if (networkBandwidth < currentBandwidth * (1 - mSwitchHysteresis.downMargin)) {
+    targetIter = ladder.begin();
+    for (SortedBWProfileListIter iter = ladder.begin(); iter != currIter && iter->first <= networkBandwidth; ++iter) {
+      targetIter = iter;
+    }
+  }
+
+  int direction = (targetIter->first > currIter->first) ? 1 : ((targetIter->first < currIter->first) ? -1 : 0);
+  if (direction == 0) {
+    state.direction = 0;
+    return currentProfileIndex;
+  }
+  long long now = getCurrentTimeMS();
+  if (state.direction != direction) {
+    state.direction = direction;
+    state.sinceMs = now;
+  }
+  long long holdMs = direction > 0 ? mSwitchHysteresis.upHoldMs : mSwitchHysteresis.downHoldMs;
+  bool oneStep = (direction > 0) ? (std::next(currIter) == targetIter) : (std::next(targetIter) == currIter);
+  if (oneStep && now - state.sinceMs < holdMs) {
+    return currentProfileIndex;
+  }
+  state.direction = 0;
+  return targetIter->second;
+}
+
+/**
+ *  @brief Debounce one step switches by time
+ */
+void ABRManager::setSwitchHysteresis(const HysteresisConfig& config)
+{
+  mSwitchHysteresis = config;
+  mSwitchHysteresisEnabled = true;
+  resetHysteresisState();
+}
+
+/**
+ *  @brief Debounce one step switches by the network consistency count
+ */
+void ABRManager::disableSwitchHysteresis()
+{
+  mSwitchHysteresisEnabled = false;
+  resetHysteresisState();
+}
+
+/**
+ *  @brief Drop the pending switches, keeps the per period states
+ */
+void ABRManager::resetHysteresisState()
+{
+  for (std::map<std::string, HysteresisState>::iterator iter = mHysteresisState.begin(); iter != mHysteresisState.end(); ++iter) {
+    iter->second.direction = 0;
+  }
+}
+
+/**
+ *  @brief Sorted ladder of a period, without inserting an unknown period
+ */
+std::map<long,int>& ABRManager::getSortedLadder(const std::string& periodId)
+{
+  std::map<std::string, std::map<long,int> >::iterator period = mSortedBWProfileList.find(periodId);
+  return period != mSortedBWProfileList.end() ? period->second : mEmptyLadder;
+}
+
+/**
+ *  @brief Enable the data saver
+ */
+void ABRManager::setDataSaver(const ABRDataSaver::Config& config)
+{
+  mDataSaver.configure(config);
+}
+
+/**
+ *  @brief Disable the data saver
+ */
+void ABRManager::disableDataSaver()
+{
+  mDataSaver.disable();
+}
+
+/**
+ *  @brief Set the hour of day source of the data saver profiles
+ */
+void ABRManager::setHourOfDaySource(HourOfDayFuncType source, void* context)
+{
+  mHourOfDaySource = source;
+  mHourOfDayContext = context;
+  mHourOfDayMinute = -1;
+}
+
+/**
+ *  @brief Set the link type used to select the data saver profile
+ */
+void ABRManager::setMeteredLink(bool metered)
+{
+  mDataSaver.setMetered(metered);
+}
+
+/**
+ *  @brief Set the content left to play, over which the session budget is spread
+ */
+void ABRManager::setContentRemaining(long long remainingMs)
+{
+  mDataSaver.setContentRemaining(remainingMs);
+}
+
+/**
+ *  @brief Account downloaded bytes in the data saver budgets
+ */
+void ABRManager::reportDownloadedBytes(long long bytes)
+{
+  mDataSaver.addBytes(bytes, getCurrentTimeMS());
+}
+
+/**
+ *  @brief Highest bitrate the data saver allows now
+ */
+long ABRManager::getDataSaverBandwidthCap() const
+{
+  if (!mDataSaver.isEnabled()) {
+    return ABRDataSaver::NO_CAP;
+  }
+  long long nowMs = getCurrentTimeMS();
+  // The hour only changes on minute boundaries of the clock: no time zone
+  // lookup per decision
+  long long minute = nowMs / MS_PER_MINUTE;
+  if (minute != mHourOfDayMinute) {
+    if (mHourOfDaySource) {
+      mHourOfDay = mHourOfDaySource(nowMs, mHourOfDayContext);
+    } else {
+      time_t now = time(NULL);
+      struct tm local;
+      mHourOfDay = localtime_r(&now, &local) ? local.tm_hour : 0;
+    }
+    mHourOfDayMinute = minute;
+  }
+  return mDataSaver.getBandwidthCap(nowMs, mHourOfDay);
+}
+
+/**
+ *  @brief Set the diminishing returns cutoff of the quality based selection
+ */
+void ABRManager::setQualityCutoff(double minGainPerMbps, double qualityCeiling)
+{
+  mQualityMinGainPerMbps = minGainPerMbps;
+  mQualityCeiling = qualityCeiling;
+}
+
+/**
+ *  @brief Update the quality score of a profile
+ */
+void ABRManager::updateProfileQuality(int profileIndex, double qualityScore)
+{
+  if (profileIndex < 0 || profileIndex >= getProfileCount()) {
+    sLogger("%s:%d Invalid profileIndex %d, profile count %d\n",
+      __FUNCTION__, __LINE__, profileIndex, getProfileCount());
+    return;
+  }
+  mProfileQuality[profileIndex] = qualityScore;
+}
+
+/**
+ *  @brief Get the quality score of a profile
+ */
+double ABRManager::getQualityOfProfile(int profileIndex) const
+{
+  if (profileIndex < 0 || profileIndex >= getProfileCount()) {
+    return 0;
+  }
+  return mProfileQuality[profileIndex];
 }
 
 // Getters/Setters
@@ -615,7 +1089,7 @@ int ABRManager::getMaxBandwidthProfile(const std::string& periodId)
  *  @brief Get the number of profiles
  */
 int ABRManager::getProfileCount() const {
-  return static_cast<int>(mProfiles.size());
+  return static_cast<int>(mProfileBandwidth.size());
 }
 
 /**
@@ -643,14 +1117,84 @@ int ABRManager::getDesiredIframeProfile() const {
 /**
  *  @brief Add new profile info into the manager
  */
-void ABRManager::addProfile(ABRManager::ProfileInfo profile) {
-  mProfiles.push_back(profile);
-  int profileCount = getProfileCount();
-  if (!mProfiles[profileCount-1].isIframeTrack) {
-	mSortedBWProfileList[mProfiles[profileCount-1].periodId][mProfiles[profileCount-1].bandwidthBitsPerSecond] = profileCount - 1;
+void ABRManager::addProfile(const ABRManager::ProfileInfo& profile) {
+  addProfileColumns(profile.isIframeTrack, profile.bandwidthBitsPerSecond, profile.width, profile.height,
+    internPeriodId(profile.periodId), profile.userData, 0);
+}
+
+/**
+ *  @brief Add new profile info into the manager, taking over its period-Id
+ */
+void ABRManager::addProfile(ABRManager::ProfileInfo&& profile) {
+  addProfileColumns(profile.isIframeTrack, profile.bandwidthBitsPerSecond, profile.width, profile.height,
+    internPeriodId(std::move(profile.periodId)), profile.userData, 0);
+}
+
+/**
+ *  @brief Add new profile into the manager from its fields
+ */
+void ABRManager::emplaceProfile(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, const std::string& periodId, int userData, double qualityScore) {
+  addProfileColumns(isIframeTrack, bandwidthBitsPerSecond, width, height, internPeriodId(periodId), userData, qualityScore);
+}
+
+/**
+ *  @brief Add new profile into the manager from its fields, taking over the period-Id
+ */
+void ABRManager::emplaceProfile(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, std::string&& periodId, int userData, double qualityScore) {
+  addProfileColumns(isIframeTrack, bandwidthBitsPerSecond, width, height, internPeriodId(std::move(periodId)), userData, qualityScore);
+}
+
+/**
+ *  @brief Get the handle of a period-Id, adding it to the period table if new
+ */
+int ABRManager::internPeriodId(const std::string& periodId) {
+  for (size_t i = 0; i < mPeriodIds.size(); i++) {
+    if (mPeriodIds[i] == periodId) {
+      return static_cast<int>(i);
+    }
+  }
+  mPeriodIds.push_back(periodId);
+  return static_cast<int>(mPeriodIds.size() - 1);
+}
+
+/**
+ *  @brief Get the handle of a period-Id, moving it to the period table if new
+ */
+int ABRManager::internPeriodId(std::string&& periodId) {
+  for (size_t i = 0; i < mPeriodIds.size(); i++) {
+    if (mPeriodIds[i] == periodId) {
+      return static_cast<int>(i);
+    }
+  }
+  mPeriodIds.push_back(std::move(periodId));
+  return static_cast<int>(mPeriodIds.size() - 1);
+}
+
+/**
+ *  @brief Append a profile to the hot and cold columns
+ */
+void ABRManager::addProfileColumns(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, int periodHandle, int userData, double qualityScore) {
+  ProfileColdInfo cold;
+  cold.width = width;
+  cold.height = height;
+  cold.userData = userData;
+
+  int profileIndex = getProfileCount();
+  mProfileBandwidth.push_back(bandwidthBitsPerSecond);
+  mProfileIsIframe.push_back(isIframeTrack);
+  mProfilePeriod.push_back(periodHandle);
+  mProfileQuality.push_back(qualityScore);
+  mProfileCold.push_back(cold);
+
+  const std::string& periodId = mPeriodIds[periodHandle];
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_ADD_PROFILE, 0, profileIndex,
+    bandwidthBitsPerSecond, isIframeTrack, width, height,
+    ABRFlightRecorder::hashPeriodId(periodId), userData);
+  if (!isIframeTrack) {
+	mSortedBWProfileList[periodId][bandwidthBitsPerSecond] = profileIndex;
 #if defined(DEBUG_ENABLED)
-	sLogger("%s: Period ID: %s\n", __FUNCTION__, mProfiles[profileCount-1].periodId.c_str());
-	sLogger("%s: bw:%ld idx:%d\n", __FUNCTION__, mProfiles[profileCount-1].bandwidthBitsPerSecond, profileCount-1);
+	sLogger("%s: Period ID: %s\n", __FUNCTION__, periodId.c_str());
+	sLogger("%s: bw:%ld idx:%d\n", __FUNCTION__, bandwidthBitsPerSecond, profileIndex);
 #endif
   }
 }
@@ -659,7 +1203,14 @@ void ABRManager::addProfile(ABRManager::ProfileInfo profile) {
  *  @brief Clear profiles
  */
 void ABRManager::clearProfiles() {
-  mProfiles.clear();
+  mFlightRecorder.record(ABRFlightRecorder::eRECORD_CLEAR_PROFILES, 0, 0);
+  mProfileBandwidth.clear();
+  mProfileIsIframe.clear();
+  mProfilePeriod.clear();
+  mProfileQuality.clear();
+  mProfileCold.clear();
+  mPeriodIds.clear();
+  mHysteresisState.clear();
   if (mSortedBWProfileList.size()) {
     mSortedBWProfileList.erase(mSortedBWProfileList.begin(),mSortedBWProfileList.end());
     mSortedBWProfileList.clear();
@@ -683,6 +1234,22 @@ void ABRManager::disableLogger() {
   sLogger = emptyLogger;
 }
 
+/**
+ *  @brief Set the clock of this instance
+ */
+void ABRManager::setClock(ClockFuncType clock, void* context) {
+  mClock = clock;
+  mClockContext = context;
+  mFlightRecorder.setClock(clock, context);
+}
+
+/**
+ *  @brief Current time of this instance
+ */
+long long ABRManager::getCurrentTimeMS() const {
+  return mClock ? mClock(mClockContext) : ABRMetrics::currentTimeMS();
+}
+
 /**
  *  @brief Set the simulator log file directory index.
  */
@@ -690,6 +1257,91 @@ void ABRManager::setLogDirectory(char driveName) {
   gsLogDirectory[0] = driveName;
 }
 
+/**
+ *  @brief Attach a persistent bandwidth history
+ */
+void ABRManager::setBandwidthStore(ABRBandwidthStore* store, const std::string& networkInterface, const std::string& cdnHost)
+{
+  mBandwidthStore = store;
+  mBandwidthStoreInterface = networkInterface;
+  mBandwidthStoreHost = cdnHost;
+}
+
+/**
+ *  @brief Attach the bandwidth estimate shared with the other processes
+ */
+void ABRManager::setSharedBandwidth(ABRSharedBandwidth* shared)
+{
+  mSharedBandwidth = shared;
+}
+
+/**
+ *  @brief Set the persisted network bandwidth, as of now
+ */
+void ABRManager::setPersistBandwidth(long bitrate)
+{
+  mPersistBandwidth = bitrate;
+  mPersistBandwidthUpdatedTime = getWallClockTimeMS();
+}
+
+/**
+ *  @brief Persist a bandwidth estimate to the attached bandwidth history
+ */
+void ABRManager::recordBandwidthHistory(long bandwidth)
+{
+  ABR_PROFILE_API(eAPI_RECORD_BANDWIDTH_HISTORY);
+  if ((mBandwidthStore || mSharedBandwidth) && bandwidth > 0) {
+    mPersistBandwidth = bandwidth;
+    mPersistBandwidthUpdatedTime = getWallClockTimeMS();
+    if (mBandwidthStore) {
+      mBandwidthStore->record(mBandwidthStoreInterface, mBandwidthStoreHost, bandwidth);
+    }
+    if (mSharedBandwidth) {
+      mSharedBandwidth->publish(bandwidth, mPersistBandwidthUpdatedTime);
+    }
+  }
+}
+
+/**
+ *  @brief Get the aggregated ABR behavior metrics
+ */
+void ABRManager::getMetrics(ABRMetrics::Snapshot& snapshot) const
+{
+  mMetrics.getSnapshot(snapshot);
+}
+
+/**
+ *  @brief Reset the ABR behavior metrics
+ */
+void ABRManager::resetMetrics()
+{
+  mMetrics.reset();
+}
+
+/**
+ *  @brief Start the flight recorder
+ */
+void ABRManager::enableFlightRecorder(int capacity)
+{
+  mFlightRecorder.enable(capacity);
+}
+
+/**
+ *  @brief Stop the flight recorder
+ */
+void ABRManager::disableFlightRecorder()
+{
+  mFlightRecorder.disable();
+}
+
+/**
+ *  @brief Write the flight recorder ring to a file
+ */
+bool ABRManager::dumpFlightRecorder(const std::string& path) const
+{
+  return mFlightRecorder.dump(path);
+}
+
 /**
  *  @brief Set the default iframe bitrate
  */
@@ -26,7 +26,12 @@
 #include <map>
 #include <string>
 #include <cstdio>
+#include "ABRMetrics.h"
+#include "ABRFlightRecorder.h"
+#include "ABRDataSaver.h"
 
+class ABRBandwidthStore;
+class ABRSharedBandwidth;
 
 /**
  * @class ABRManager
@@ -73,6 +78,33 @@ public:
     int userData;
   };
 
+  /**
+   * @brief Time-based switch hysteresis of getProfileIndexByBitrateRampUpOrDown
+   */
+  struct HysteresisConfig {
+    /**
+     * @brief Time (ms) a one step ramp up must stay supported before switching
+     */
+    long long upHoldMs;
+
+    /**
+     * @brief Time (ms) a one step ramp down must stay needed before switching
+     */
+    long long downHoldMs;
+
+    /**
+     * @brief A higher profile is supported if the network bandwidth exceeds
+     * its bitrate by this fraction
+     */
+    double upMargin;
+
+    /**
+     * @brief A ramp down is needed if the network bandwidth is below the
+     * current bitrate by more than this fraction
+     */
+    double downMargin;
+  };
+
   /**
    * @brief Logger type
    */
@@ -107,6 +139,41 @@ public:
    */
   int getInitialProfileIndex(bool chooseMediumProfile, const std::string& periodId= std::string());
 
+  /**
+   * @fn getStartupProfileIndex
+   * @brief Choose the initial profile for the startup estimate, see
+   * getStartupEstimate
+   *
+   * @param periodId empty string by default, Period-Id of the profiles
+   * @return The initial profile index
+   */
+  int getStartupProfileIndex(const std::string& periodId= std::string());
+
+  /**
+   * @fn getStartupEstimate
+   * @brief Blend the persisted bandwidth estimate with the default init
+   * bitrate, by a confidence decaying with the age of the estimate and
+   * growing with its number of samples
+   *
+   * @param[out] confidence Weight given to the persisted estimate, 0 to 1
+   * @return The startup bandwidth estimate
+   */
+  long getStartupEstimate(double& confidence);
+
+  /**
+   * @fn getStartupProbeProfileIndex
+   * @brief Correct the initial profile with the throughput of the first
+   * fragments: up to the STARTUP_PROBE_FRAGMENTS-th fragment, move straight
+   * to the highest profile under the measured throughput
+   *
+   * @param currentProfileIndex The current profile index
+   * @param probeBandwidth Throughput measured on the fragment, in bps
+   * @param fragmentNumber Number of fragments downloaded in the session, 1 for the first
+   * @param periodId empty string by default, Period-Id of profiles
+   * @return The profile index, currentProfileIndex after the probe fragments
+   */
+  int getStartupProbeProfileIndex(int currentProfileIndex, long probeBandwidth, int fragmentNumber, const std::string& periodId= std::string());
+
   /**
    * @fn updateProfile
    * @return void
@@ -162,6 +229,18 @@ public:
    */
   int getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, long currentBandwidth, long networkBandwidth, int nwConsistencyCnt = DEFAULT_ABR_NW_CONSISTENCY_COUNT, const std::string& periodId= std::string());
 
+  /**
+   * @fn getProfileChangeUpCount
+   * @return Consecutive one step ramp ups seen by getProfileIndexByBitrateRampUpOrDown
+   */
+  int getProfileChangeUpCount() const { return mAbrProfileChangeUpCount; }
+
+  /**
+   * @fn getProfileChangeDownCount
+   * @return Consecutive one step ramp downs seen by getProfileIndexByBitrateRampUpOrDown
+   */
+  int getProfileChangeDownCount() const { return mAbrProfileChangeDownCount; }
+
   /**
    * @fn getBandwidthOfProfile
    *
@@ -186,6 +265,61 @@ public:
    * @return int index of the max bandwidth
    */
   int getMaxBandwidthProfile(const std::string& periodId = std::string());
+
+  /**
+   * @fn getProfileIndexByQuality
+   * @brief Pick the profile of highest quality under the network bandwidth,
+   * skipping the profiles whose quality gain per extra Mbps is below the
+   * cutoff set by setQualityCutoff. If a profile of the period has no
+   * quality score, pick the highest bitrate under the network bandwidth.
+   *
+   * @param networkBandwidth The current available bandwidth (network bandwidth)
+   * @param periodId empty string by default, Period-Id of profiles
+   * @return int Profile index, the lowest one if none fits
+   */
+  int getProfileIndexByQuality(long networkBandwidth, const std::string& periodId = std::string());
+
+  /**
+   * @fn getProfileIndexByQualityRampUpOrDown
+   * @brief Same as getProfileIndexByBitrateRampUpOrDown, without ramping up
+   * past the profile picked by getProfileIndexByQuality
+   *
+   * @param currentProfileIndex The current profile index
+   * @param currentBandwidth The current band width
+   * @param networkBandwidth The current available bandwidth (network bandwidth)
+   * @param nwConsistencyCnt Network consistency count, used for bitrate ramping up/down
+   * @param periodId empty string by default, Period-Id of profiles
+   * @return int Profile index
+   */
+  int getProfileIndexByQualityRampUpOrDown(int currentProfileIndex, long currentBandwidth, long networkBandwidth, int nwConsistencyCnt = DEFAULT_ABR_NW_CONSISTENCY_COUNT, const std::string& periodId= std::string());
+
+  /**
+   * @fn setQualityCutoff
+   * @brief Set the diminishing returns cutoff of the quality based selection
+   *
+   * @param minGainPerMbps Minimum quality gain per extra Mbps to move to a
+   * higher profile, 0 to accept any gain
+   * @param qualityCeiling Quality above which no higher profile is picked,
+   * 0 for none
+   */
+  void setQualityCutoff(double minGainPerMbps, double qualityCeiling);
+
+  /**
+   * @fn updateProfileQuality
+   * @brief Update the quality score of a profile, eg. per segment
+   *
+   * @param profileIndex The profile index
+   * @param qualityScore Quality score, 0 if unknown
+   */
+  void updateProfileQuality(int profileIndex, double qualityScore);
+
+  /**
+   * @fn getQualityOfProfile
+   *
+   * @param profileIndex The profile index
+   * @return Quality score of the profile, 0 if unknown
+   */
+  double getQualityOfProfile(int profileIndex) const;
 public:
   // Getters/Setters
   /**
@@ -218,9 +352,37 @@ public:
 
   /**
    * @fn addProfile
+   * @brief Add a profile, with no quality score until updateProfileQuality
+   *
    * @param profile The profile info
    */
-  void addProfile(ProfileInfo profile);
+  void addProfile(const ProfileInfo& profile);
+
+  /**
+   * @fn addProfile
+   * @param profile The profile info, its period-Id is moved from
+   */
+  void addProfile(ProfileInfo&& profile);
+
+  /**
+   * @fn emplaceProfile
+   * @brief Add a profile from its fields, without building a ProfileInfo
+   *
+   * @param isIframeTrack Is iframe track
+   * @param bandwidthBitsPerSecond Bandwidth / second (Bitrate)
+   * @param width Width of resolution
+   * @param height Height of resolution
+   * @param periodId Period-Id of the profile
+   * @param userData profileIndex or PeriodIndex
+   * @param qualityScore Perceptual quality score, 0 if unknown
+   */
+  void emplaceProfile(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, const std::string& periodId, int userData, double qualityScore = 0);
+
+  /**
+   * @fn emplaceProfile
+   * @brief Add a profile from its fields, the period-Id is moved from
+   */
+  void emplaceProfile(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, std::string&& periodId, int userData, double qualityScore = 0);
 
   /**
    * @fn clearProfiles
@@ -240,6 +402,22 @@ public:
    */
   static void disableLogger();
 
+  /**
+   * @brief Clock function type, returns the current time in ms
+   */
+  typedef long long (*ClockFuncType)(void* context);
+
+  /**
+   * @fn setClock
+   * @brief Use a virtual clock for the time of this instance, eg. to
+   * simulate sessions faster than real time. The flight recorder records
+   * are timestamped with it too.
+   *
+   * @param clock Clock function, NULL for the system clock
+   * @param context Argument of the clock function
+   */
+  void setClock(ClockFuncType clock, void* context);
+
   /**
    * @fn setLogDirectory
    */
@@ -263,7 +441,7 @@ public:
     *
     * @param network bitrate
     */
-   static void setPersistBandwidth(long bitrate){mPersistBandwidth = bitrate;}
+   static void setPersistBandwidth(long bitrate);
    /**
     * @brief Get Persisted Network Bandwidth
     *
@@ -271,14 +449,285 @@ public:
     */
    static long getPersistBandwidth() { return mPersistBandwidth;}
 
+  /**
+   * @fn setBandwidthStore
+   * @brief Attach a persistent bandwidth history, used to seed the
+   * initial profile and updated with new estimates
+   *
+   * @param store The bandwidth history, NULL to detach
+   * @param networkInterface Network interface the session uses
+   * @param cdnHost CDN host the session downloads from
+   */
+  void setBandwidthStore(ABRBandwidthStore* store, const std::string& networkInterface, const std::string& cdnHost);
+
+  /**
+   * @fn setSharedBandwidth
+   * @brief Attach the bandwidth estimate shared with the other player
+   * processes, used to seed the initial profile when it is fresher than the
+   * persisted one and updated with new estimates
+   *
+   * @param shared The shared estimate, NULL to detach
+   */
+  void setSharedBandwidth(ABRSharedBandwidth* shared);
+
+  /**
+   * @fn recordBandwidthHistory
+   * @brief Persist a bandwidth estimate, no-op without a bandwidth store or
+   * a shared estimate
+   *
+   * @param bandwidth The estimated network bandwidth
+   */
+  void recordBandwidthHistory(long bandwidth);
+
+  /**
+   * @fn getMetrics
+   * @brief Get the aggregated ABR behavior metrics
+   *
+   * @param[out] snapshot Current metrics
+   */
+  void getMetrics(ABRMetrics::Snapshot& snapshot) const;
+
+  /**
+   * @fn resetMetrics
+   */
+  void resetMetrics();
+
+  /**
+   * @fn setSwitchHysteresis
+   * @brief Debounce the one step switches of
+   * getProfileIndexByBitrateRampUpOrDown by time, per period, instead of by
+   * the network consistency count
+   *
+   * @param config Hold times and bandwidth margins
+   */
+  void setSwitchHysteresis(const HysteresisConfig& config);
+
+  /**
+   * @fn disableSwitchHysteresis
+   * @brief Back to the network consistency count
+   */
+  void disableSwitchHysteresis();
+
+  /**
+   * @fn setDataSaver
+   * @brief Enable the data saver: ramp decisions keep the bitrate under
+   * the cap derived from the configuration and the downloaded bytes
+   *
+   * @param config Maximum bitrate, hourly and session byte budgets
+   */
+  void setDataSaver(const ABRDataSaver::Config& config);
+
+  /**
+   * @fn disableDataSaver
+   */
+  void disableDataSaver();
+
+  /**
+   * @brief Hour of day source type
+   *
+   * @param nowMs Time of the clock set by setClock
+   * @param context Context given to setHourOfDaySource
+   * @return Local hour of day, 0 to 23
+   */
+  typedef int (*HourOfDayFuncType)(long long nowMs, void* context);
+
+  /**
+   * @fn setHourOfDaySource
+   * @brief Replace the local wall clock hour that selects the data saver
+   * profile, eg. to derive it from a virtual clock set with setClock
+   *
+   * @param source Hour of day source, NULL for the local wall clock
+   * @param context Argument of source
+   */
+  void setHourOfDaySource(HourOfDayFuncType source, void* context);
+
+  /**
+   * @fn setMeteredLink
+   * @param metered The session runs over a metered link
+   */
+  void setMeteredLink(bool metered);
+
+  /**
+   * @fn setContentRemaining
+   * @param remainingMs Content left to play in ms, -1 if unknown (live)
+   */
+  void setContentRemaining(long long remainingMs);
+
+  /**
+   * @fn reportDownloadedBytes
+   * @brief Account the bytes of a download (any media type) in the data
+   * saver budgets
+   *
+   * @param bytes Downloaded bytes
+   */
+  void reportDownloadedBytes(long long bytes);
+
+  /**
+   * @fn getDataSaverBandwidthCap
+   * @return Highest bitrate the data saver allows now, ABRDataSaver::NO_CAP
+   * if disabled
+   */
+  long getDataSaverBandwidthCap() const;
+
+  /**
+   * @fn enableFlightRecorder
+   * @brief Start recording ABR inputs and decisions into a ring buffer
+   *
+   * @param capacity Number of records kept, rounded up to a power of two
+   */
+  void enableFlightRecorder(int capacity);
+
+  /**
+   * @fn disableFlightRecorder
+   */
+  void disableFlightRecorder();
+
+  /**
+   * @fn dumpFlightRecorder
+   * @brief Write the recorded ring to a file, see ABRFlightRecorder::DumpHeader
+   *
+   * @param path File to write
+   * @return true on success
+   */
+  bool dumpFlightRecorder(const std::string& path) const;
+
 
    static LoggerFuncType logprintf;
 
+protected:
+  /**
+   * @fn getCurrentTimeMS
+   * @return Time of the clock set by setClock, or the monotonic time in ms
+   */
+  long long getCurrentTimeMS() const;
+
+  /**
+   * @brief Clock set by setClock, NULL for the system clock
+   */
+  ClockFuncType mClock;
+
+  /**
+   * @brief Argument of mClock
+   */
+  void* mClockContext;
+
+  /**
+   * @brief Aggregated ABR behavior metrics
+   */
+  ABRMetrics mMetrics;
+
+  /**
+   * @brief Flight recorder of ABR inputs and decisions
+   */
+  ABRFlightRecorder mFlightRecorder;
+
+  /**
+   * @brief Bitrate cap and byte budgets
+   */
+  ABRDataSaver mDataSaver;
+
+  /**
+   * @brief Hour of day source set by setHourOfDaySource, NULL for the local
+   * wall clock
+   */
+  HourOfDayFuncType mHourOfDaySource;
+  void* mHourOfDayContext;
+
+  /**
+   * @brief Hour of day of the data saver, read once per minute of the clock
+   * (mHourOfDayMinute, -1 before the first read)
+   */
+  mutable int mHourOfDay;
+  mutable long long mHourOfDayMinute;
+
 private:
   /**
-   * @brief A list of available profiles.
+   * @brief Rarely read fields of a profile
    */
-  std::vector<ProfileInfo> mProfiles;
+  struct ProfileColdInfo {
+    int width;
+    int height;
+    int userData;
+  };
+
+  /**
+   * @brief Add a profile to the columns below
+   */
+  void addProfileColumns(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, int periodHandle, int userData, double qualityScore);
+
+  /**
+   * @brief Pending switch of a period, for the time-based hysteresis
+   */
+  struct HysteresisState {
+    /**
+     * @brief 1 for a pending ramp up, -1 for a ramp down, 0 if none
+     */
+    int direction;
+
+    /**
+     * @brief Time the pending switch was first seen
+     */
+    long long sinceMs;
+  };
+
+  /**
+   * @brief Ramp up/down decision with the time-based hysteresis
+   */
+  int getProfileIndexByHysteresis(int currentProfileIndex, long currentBandwidth, long networkBandwidth, const std::string& periodId);
+
+  /**
+   * @brief Clear the pending switches, keeps the state of each period
+   */
+  void resetHysteresisState();
+
+  /**
+   * @brief Sorted ladder of a period, an empty one for an unknown period.
+   * Unlike mSortedBWProfileList[periodId], never inserts.
+   */
+  std::map<long,int>& getSortedLadder(const std::string& periodId);
+
+  /**
+   * @brief A temporary structure of iframe track info
+   */
+  struct IframeTrackInfo {
+    long bandwidth;
+    int idx;
+  };
+
+  /**
+   * @brief Highest profile of a period with a bitrate under bandwidth, the
+   * lowest one if none
+   */
+  int getHighestProfileUnder(long bandwidth, const std::string& periodId);
+
+  /**
+   * @brief Handle (index in mPeriodIds) of a period-Id
+   */
+  int internPeriodId(const std::string& periodId);
+  int internPeriodId(std::string&& periodId);
+
+  /**
+   * @brief The available profiles, stored as columns indexed by profile index.
+   * Hot columns: bandwidth, iframe flag and period handle, read by the scans.
+   */
+  std::vector<long> mProfileBandwidth;
+  std::vector<char> mProfileIsIframe;
+  std::vector<int> mProfilePeriod;
+
+  /**
+   * @brief Quality score column, read by the quality based selection
+   */
+  std::vector<double> mProfileQuality;
+
+  /**
+   * @brief Cold columns: resolution and user data
+   */
+  std::vector<ProfileColdInfo> mProfileCold;
+
+  /**
+   * @brief Distinct period-Ids of the profiles, indexed by period handle
+   */
+  std::vector<std::string> mPeriodIds;
 
   /**
    * @brief A sorted list of profiles with periodId.
@@ -291,6 +740,16 @@ private:
    */
   typedef std::map<long, int>::iterator SortedBWProfileListIter;
 
+  /**
+   * @brief Ladder returned for an unknown period, always empty
+   */
+  std::map<long,int> mEmptyLadder;
+
+  /**
+   * @brief Scratch of updateProfile, sized to the profile count
+   */
+  std::vector<IframeTrackInfo> mIframeTrackInfo;
+
   /**
    * @brief Define type: reverse iterator of SortedBWProfileListIter 
    */
@@ -322,6 +781,31 @@ private:
    */
   int mAbrProfileChangeDownCount;
 
+  /**
+   * @brief Time-based hysteresis replaces the network consistency count
+   */
+  bool mSwitchHysteresisEnabled;
+
+  /**
+   * @brief Hold times and margins of the time-based hysteresis
+   */
+  HysteresisConfig mSwitchHysteresis;
+
+  /**
+   * @brief Pending switch of each period
+   */
+  std::map<std::string, HysteresisState> mHysteresisState;
+
+  /**
+   * @brief Minimum quality gain per extra Mbps of the quality based selection
+   */
+  double mQualityMinGainPerMbps;
+
+  /**
+   * @brief Quality above which the quality based selection stops, 0 for none
+   */
+  double mQualityCeiling;
+
   /**
    * @brief Logger function pointer
    */
@@ -332,6 +816,26 @@ private:
    */
   long mDefaultIframeBitrate;
 
+  /**
+   * @brief Persistent bandwidth history (optional, not owned)
+   */
+  ABRBandwidthStore* mBandwidthStore;
+
+  /**
+   * @brief Network interface key of the bandwidth history
+   */
+  std::string mBandwidthStoreInterface;
+
+  /**
+   * @brief CDN host key of the bandwidth history
+   */
+  std::string mBandwidthStoreHost;
+
+  /**
+   * @brief Bandwidth estimate shared with the other processes (optional, not owned)
+   */
+  ABRSharedBandwidth* mSharedBandwidth;
+
 public:
   /**
    * @brief Invalid profile index
@@ -360,6 +864,28 @@ private:
    * Used when bitrate ramping up/down
    */
   static const int DEFAULT_ABR_NW_CONSISTENCY_COUNT = 2;
+
+  /**
+   * @brief Max age of a persisted bandwidth summary used for the initial profile
+   */
+  static const long long MAX_BANDWIDTH_HISTORY_AGE_MS = 6LL * 60 * 60 * 1000;
+
+  /**
+   * @brief Age halving the confidence in a persisted bandwidth estimate
+   */
+  static const long long STARTUP_ESTIMATE_HALF_LIFE_MS = 30LL * 60 * 1000;
+
+  /**
+   * @brief Number of samples of a persisted estimate giving it half confidence
+   */
+  static const int STARTUP_ESTIMATE_HALF_SAMPLES = 2;
+
+public:
+  /**
+   * @brief Number of fragments getStartupProbeProfileIndex corrects the
+   * initial profile on
+   */
+  static const int STARTUP_PROBE_FRAGMENTS = 2;
 };
 extern void ABRLogger(const char* levelstr,const char* file, int line,const char* fmt, ...);
 #endif
@@ -0,0 +1,209 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRMetrics.cpp
+ * @brief Aggregated counters of ABR behavior
+ ***************************************************/
+
+#include "ABRMetrics.h"
+#include <chrono>
+
+/**
+ * @brief Upper bounds (percent, exclusive) of the estimate error buckets,
+ * the last bucket is unbounded
+ */
+static const int ESTIMATE_ERROR_BOUNDS[ABRMetrics::ESTIMATE_ERROR_BUCKETS - 1] = { -50, -25, -10, 0, 10, 25, 50 };
+
+/**
+ * @brief Constructor of ABRMetrics
+ */
+ABRMetrics::ABRMetrics() {
+  mConfigVersion.store(1, std::memory_order_relaxed);
+  reset();
+}
+
+/**
+ * @brief Copy constructor of ABRMetrics
+ */
+ABRMetrics::ABRMetrics(const ABRMetrics& other) {
+  copyFrom(other);
+}
+
+/**
+ * @brief Assignment of ABRMetrics
+ */
+ABRMetrics& ABRMetrics::operator=(const ABRMetrics& other) {
+  if (this != &other) {
+    copyFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Copy every counter of other
+ */
+void ABRMetrics::copyFrom(const ABRMetrics& other) {
+  for (int i = 0; i < MAX_BITRATE_CHANGE_REASONS; i++) {
+    mSwitchesUp[i].store(other.mSwitchesUp[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mSwitchesDown[i].store(other.mSwitchesDown[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  for (int i = 0; i < MAX_PROFILE_BUCKETS; i++) {
+    mTimeInProfileMs[i].store(other.mTimeInProfileMs[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  for (int i = 0; i < ESTIMATE_ERROR_BUCKETS; i++) {
+    mEstimateError[i].store(other.mEstimateError[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  mOutliersDropped.store(other.mOutliersDropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mBitsPlayed.store(other.mBitsPlayed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mTimePlayedMs.store(other.mTimePlayedMs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mLastProfileIndex.store(other.mLastProfileIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mLastProfileBandwidth.store(other.mLastProfileBandwidth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mLastProfileTimeMs.store(other.mLastProfileTimeMs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mLastEstimate.store(other.mLastEstimate.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mConfigVersion.store(other.mConfigVersion.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  mConfigSwitches.store(other.mConfigSwitches.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Count a bitrate switch
+ */
+void ABRMetrics::recordSwitch(int reason, long fromBandwidth, long toBandwidth) {
+  if (reason < 0 || reason >= MAX_BITRATE_CHANGE_REASONS || fromBandwidth == toBandwidth) {
+    return;
+  }
+  if (toBandwidth > fromBandwidth) {
+    mSwitchesUp[reason].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    mSwitchesDown[reason].fetch_add(1, std::memory_order_relaxed);
+  }
+  mConfigSwitches.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Account time to the previously reported profile
+ */
+void ABRMetrics::recordProfileTime(int profileIndex, long bandwidth, long long nowMs) {
+  int lastIndex = mLastProfileIndex.exchange(profileIndex, std::memory_order_relaxed);
+  long lastBandwidth = mLastProfileBandwidth.exchange(bandwidth, std::memory_order_relaxed);
+  long long lastTime = mLastProfileTimeMs.exchange(nowMs, std::memory_order_relaxed);
+
+  if (lastIndex < 0 || lastTime <= 0 || nowMs <= lastTime) {
+    return;
+  }
+  unsigned long long elapsed = (unsigned long long)(nowMs - lastTime);
+  int bucket = (lastIndex < MAX_PROFILE_BUCKETS) ? lastIndex : (MAX_PROFILE_BUCKETS - 1);
+  mTimeInProfileMs[bucket].fetch_add(elapsed, std::memory_order_relaxed);
+  if (lastBandwidth > 0) {
+    mBitsPlayed.fetch_add((unsigned long long)lastBandwidth * elapsed / 1000, std::memory_order_relaxed);
+  }
+  mTimePlayedMs.fetch_add(elapsed, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Remember the last estimate, to compare with later measurements
+ */
+void ABRMetrics::recordEstimate(long estimatedBps) {
+  if (estimatedBps > 0) {
+    mLastEstimate.store(estimatedBps, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Add the error of the last estimate to the histogram
+ */
+void ABRMetrics::recordThroughputSample(long measuredBps) {
+  long estimate = mLastEstimate.load(std::memory_order_relaxed);
+  if (estimate <= 0 || measuredBps <= 0) {
+    return;
+  }
+  long long errorPercent = ((long long)measuredBps - estimate) * 100 / estimate;
+  int bucket = 0;
+  while (bucket < ESTIMATE_ERROR_BUCKETS - 1 && errorPercent >= ESTIMATE_ERROR_BOUNDS[bucket]) {
+    bucket++;
+  }
+  mEstimateError[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Count samples dropped by the outlier filter
+ */
+void ABRMetrics::recordOutliersDropped(int count) {
+  if (count > 0) {
+    mOutliersDropped.fetch_add(count, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Read the metrics
+ */
+void ABRMetrics::getSnapshot(Snapshot& snapshot) const {
+  for (int i = 0; i < MAX_BITRATE_CHANGE_REASONS; i++) {
+    snapshot.switchesUp[i] = mSwitchesUp[i].load(std::memory_order_relaxed);
+    snapshot.switchesDown[i] = mSwitchesDown[i].load(std::memory_order_relaxed);
+  }
+  for (int i = 0; i < MAX_PROFILE_BUCKETS; i++) {
+    snapshot.timeInProfileMs[i] = mTimeInProfileMs[i].load(std::memory_order_relaxed);
+  }
+  for (int i = 0; i < ESTIMATE_ERROR_BUCKETS; i++) {
+    snapshot.estimateError[i] = mEstimateError[i].load(std::memory_order_relaxed);
+  }
+  snapshot.outliersDropped = mOutliersDropped.load(std::memory_order_relaxed);
+  snapshot.configVersion = mConfigVersion.load(std::memory_order_relaxed);
+  snapshot.configSwitches = mConfigSwitches.load(std::memory_order_relaxed);
+  unsigned long long timePlayed = mTimePlayedMs.load(std::memory_order_relaxed);
+  snapshot.timeWeightedBitrate = timePlayed ? (long)(mBitsPlayed.load(std::memory_order_relaxed) * 1000 / timePlayed) : 0;
+}
+
+/**
+ * @brief Clear every counter
+ */
+void ABRMetrics::reset() {
+  for (int i = 0; i < MAX_BITRATE_CHANGE_REASONS; i++) {
+    mSwitchesUp[i].store(0, std::memory_order_relaxed);
+    mSwitchesDown[i].store(0, std::memory_order_relaxed);
+  }
+  for (int i = 0; i < MAX_PROFILE_BUCKETS; i++) {
+    mTimeInProfileMs[i].store(0, std::memory_order_relaxed);
+  }
+  for (int i = 0; i < ESTIMATE_ERROR_BUCKETS; i++) {
+    mEstimateError[i].store(0, std::memory_order_relaxed);
+  }
+  mOutliersDropped.store(0, std::memory_order_relaxed);
+  mBitsPlayed.store(0, std::memory_order_relaxed);
+  mTimePlayedMs.store(0, std::memory_order_relaxed);
+  mLastProfileIndex.store(-1, std::memory_order_relaxed);
+  mLastProfileBandwidth.store(0, std::memory_order_relaxed);
+  mLastProfileTimeMs.store(0, std::memory_order_relaxed);
+  mLastEstimate.store(0, std::memory_order_relaxed);
+  mConfigSwitches.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Change the configuration version in effect
+ */
+void ABRMetrics::setConfigVersion(unsigned version) {
+  mConfigVersion.store(version, std::memory_order_relaxed);
+  mConfigSwitches.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Monotonic time in ms
+ */
+long long ABRMetrics::currentTimeMS() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,214 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRMetrics.h
+ * @brief Aggregated counters of ABR behavior
+ ***************************************************/
+
+#ifndef ABR_METRICS_H
+#define ABR_METRICS_H
+
+#include <atomic>
+
+/**
+ * @class ABRMetrics
+ * @brief Counters and fixed-bucket histograms describing what the ABR did
+ *
+ * All updates are relaxed atomic operations, cheap enough to keep the
+ * collection enabled in production. getSnapshot() may be called from any
+ * thread, the snapshot is not taken atomically across counters.
+ */
+class ABRMetrics {
+public:
+  /**
+   * @brief Number of bitrate change reasons, matches
+   * HybridABRManager::eAAMP_BITRATE_CHANGE_MAX
+   */
+  static const int MAX_BITRATE_CHANGE_REASONS = 10;
+
+  /**
+   * @brief Reason of the switches decided by the bandwidth based ramp up/down,
+   * matches HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR
+   */
+  static const int BITRATE_CHANGE_BY_ABR = 0;
+
+  /**
+   * @brief Number of profile buckets, the last one collects every
+   * profile index >= MAX_PROFILE_BUCKETS - 1
+   */
+  static const int MAX_PROFILE_BUCKETS = 16;
+
+  /**
+   * @brief Number of buckets of the estimate error histogram, the bucket
+   * upper bounds (percent) are -50, -25, -10, 0, 10, 25, 50 and +inf
+   */
+  static const int ESTIMATE_ERROR_BUCKETS = 8;
+
+  /**
+   * @brief Point in time copy of the metrics
+   */
+  struct Snapshot {
+    /**
+     * @brief Switches to a higher bitrate, by bitrate change reason
+     */
+    unsigned long long switchesUp[MAX_BITRATE_CHANGE_REASONS];
+
+    /**
+     * @brief Switches to a lower bitrate, by bitrate change reason
+     */
+    unsigned long long switchesDown[MAX_BITRATE_CHANGE_REASONS];
+
+    /**
+     * @brief Time-weighted average bitrate in bps
+     */
+    long timeWeightedBitrate;
+
+    /**
+     * @brief Time (ms) spent in each profile index
+     */
+    unsigned long long timeInProfileMs[MAX_PROFILE_BUCKETS];
+
+    /**
+     * @brief Distribution of (measured - estimated) / estimated throughput
+     */
+    unsigned long long estimateError[ESTIMATE_ERROR_BUCKETS];
+
+    /**
+     * @brief Samples dropped by the cache outlier filter
+     */
+    unsigned long long outliersDropped;
+
+    /**
+     * @brief Configuration version in effect
+     */
+    unsigned configVersion;
+
+    /**
+     * @brief Switches made since configVersion was published
+     */
+    unsigned long long configSwitches;
+  };
+
+  /**
+   * @fn ABRMetrics
+   */
+  ABRMetrics();
+
+  /**
+   * @fn ABRMetrics
+   * @brief Copy the current counter values
+   */
+  ABRMetrics(const ABRMetrics& other);
+
+  /**
+   * @fn operator=
+   * @brief Copy the current counter values
+   */
+  ABRMetrics& operator=(const ABRMetrics& other);
+
+  /**
+   * @fn recordSwitch
+   *
+   * @param reason Bitrate change reason
+   * @param fromBandwidth Bitrate of the current profile
+   * @param toBandwidth Bitrate of the new profile
+   */
+  void recordSwitch(int reason, long fromBandwidth, long toBandwidth);
+
+  /**
+   * @fn recordProfileTime
+   * @brief Account the time since the previous call to the profile reported
+   * by the previous call, then make profileIndex the current one
+   *
+   * @param profileIndex The current profile index
+   * @param bandwidth Bitrate of the current profile
+   * @param nowMs Current time in ms
+   */
+  void recordProfileTime(int profileIndex, long bandwidth, long long nowMs);
+
+  /**
+   * @fn recordEstimate
+   * @param estimatedBps Newly estimated network bandwidth
+   */
+  void recordEstimate(long estimatedBps);
+
+  /**
+   * @fn recordThroughputSample
+   * @brief Compare a measured throughput with the last estimate
+   *
+   * @param measuredBps Throughput measured on a download
+   */
+  void recordThroughputSample(long measuredBps);
+
+  /**
+   * @fn recordOutliersDropped
+   * @param count Number of samples dropped as outliers
+   */
+  void recordOutliersDropped(int count);
+
+  /**
+   * @fn setConfigVersion
+   * @brief Make version the configuration in effect, restarts configSwitches
+   *
+   * @param version Configuration version
+   */
+  void setConfigVersion(unsigned version);
+
+  /**
+   * @fn getSnapshot
+   * @param[out] snapshot Current metrics
+   */
+  void getSnapshot(Snapshot& snapshot) const;
+
+  /**
+   * @fn reset
+   */
+  void reset();
+
+  /**
+   * @fn currentTimeMS
+   * @return Monotonic time in ms
+   */
+  static long long currentTimeMS();
+
+private:
+  void copyFrom(const ABRMetrics& other);
+
+  std::atomic<unsigned long long> mSwitchesUp[MAX_BITRATE_CHANGE_REASONS];
+  std::atomic<unsigned long long> mSwitchesDown[MAX_BITRATE_CHANGE_REASONS];
+  std::atomic<unsigned long long> mTimeInProfileMs[MAX_PROFILE_BUCKETS];
+  std::atomic<unsigned long long> mEstimateError[ESTIMATE_ERROR_BUCKETS];
+  std::atomic<unsigned long long> mOutliersDropped;
+
+  /**
+   * @brief Total bits played (bitrate x time), for the time-weighted average
+   */
+  std::atomic<unsigned long long> mBitsPlayed;
+
+  /**
+   * @brief Total time (ms) accounted in mBitsPlayed
+   */
+  std::atomic<unsigned long long> mTimePlayedMs;
+
+  std::atomic<int> mLastProfileIndex;
+  std::atomic<long> mLastProfileBandwidth;
+  std::atomic<long long> mLastProfileTimeMs;
+  std::atomic<long> mLastEstimate;
+  std::atomic<unsigned> mConfigVersion;
+  std::atomic<unsigned long long> mConfigSwitches;
+};
+#endif
@@ -0,0 +1,231 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRQoEScore.cpp
+ * @brief Online QoE score of a playback session
+ ***************************************************/
+
+#include "ABRQoEScore.h"
+#include <cmath>
+
+/**
+ * @brief Default weights: linear utility in Mbps, rebuffer and startup
+ * weighted as the top bitrate of a typical HD ladder (Yin et al., SIGCOMM 2015)
+ */
+static const ABRQoEScore::Weights DEFAULT_QOE_WEIGHTS = { false, 300000, 1.0, 4.3, 4.3 };
+
+/**
+ * @brief Constructor of ABRQoEScore
+ */
+ABRQoEScore::ABRQoEScore() :
+  mWeights(DEFAULT_QOE_WEIGHTS),
+  mBucketDurationMs(DEFAULT_WINDOW_MS / WINDOW_BUCKETS),
+  mNewestBucket(0),
+  mHasPrevious(false),
+  mPreviousUtility(0) {
+  reset();
+}
+
+/**
+ * @brief Set the QoE weights
+ */
+void ABRQoEScore::setWeights(const Weights& weights) {
+  mWeights = weights;
+}
+
+/**
+ * @brief Set the rolling window length
+ */
+void ABRQoEScore::setWindow(long long windowMs) {
+  mBucketDurationMs = windowMs / WINDOW_BUCKETS;
+  if (mBucketDurationMs <= 0) {
+    mBucketDurationMs = 1;
+  }
+  for (int i = 0; i < WINDOW_BUCKETS; i++) {
+    clearTotals(mBuckets[i]);
+  }
+  mNewestBucket = 0;
+}
+
+/**
+ * @brief Account a fragment
+ */
+void ABRQoEScore::onFragment(long bitrate, long durationMs, long long nowMs) {
+  if (bitrate <= 0 || durationMs <= 0) {
+    return;
+  }
+  Totals& bucket = bucketAt(nowMs);
+  double utility = utilityOf(bitrate);
+  double duration = durationMs / 1000.0;
+
+  mSession.utility += utility * duration;
+  bucket.utility += utility * duration;
+  mSession.contentDuration += duration;
+  bucket.contentDuration += duration;
+  mSession.fragmentCount++;
+  bucket.fragmentCount++;
+
+  if (mHasPrevious && utility != mPreviousUtility) {
+    double change = std::fabs(utility - mPreviousUtility);
+    mSession.switchTerm += change;
+    bucket.switchTerm += change;
+    mSession.switchCount++;
+    bucket.switchCount++;
+  }
+  mHasPrevious = true;
+  mPreviousUtility = utility;
+}
+
+/**
+ * @brief Account a stall
+ */
+void ABRQoEScore::onStall(long durationMs, long long nowMs) {
+  if (durationMs <= 0) {
+    return;
+  }
+  Totals& bucket = bucketAt(nowMs);
+  double duration = durationMs / 1000.0;
+  mSession.rebufferTerm += duration;
+  bucket.rebufferTerm += duration;
+  mSession.rebufferDuration += duration;
+  bucket.rebufferDuration += duration;
+}
+
+/**
+ * @brief Account the startup delay
+ */
+void ABRQoEScore::onStartup(long delayMs, long long nowMs) {
+  if (delayMs <= 0) {
+    return;
+  }
+  Totals& bucket = bucketAt(nowMs);
+  double delay = delayMs / 1000.0;
+  mSession.startupTerm += delay;
+  bucket.startupTerm += delay;
+}
+
+/**
+ * @brief QoE of the session
+ */
+void ABRQoEScore::getSessionScore(Score& score) const {
+  toScore(mSession, score);
+}
+
+/**
+ * @brief QoE of the rolling window ending at nowMs
+ */
+void ABRQoEScore::getWindowScore(long long nowMs, Score& score) const {
+  Totals totals;
+  clearTotals(totals);
+  long long nowBucket = nowMs / mBucketDurationMs;
+  long long first = nowBucket - WINDOW_BUCKETS + 1;
+  if (first < mNewestBucket - WINDOW_BUCKETS + 1) {
+    first = mNewestBucket - WINDOW_BUCKETS + 1;
+  }
+  long long last = (nowBucket < mNewestBucket) ? nowBucket : mNewestBucket;
+  for (long long idx = (first > 0 ? first : 0); idx <= last; idx++) {
+    addTotals(totals, mBuckets[idx % WINDOW_BUCKETS]);
+  }
+  toScore(totals, score);
+}
+
+/**
+ * @brief Start a new session
+ */
+void ABRQoEScore::reset() {
+  clearTotals(mSession);
+  for (int i = 0; i < WINDOW_BUCKETS; i++) {
+    clearTotals(mBuckets[i]);
+  }
+  mNewestBucket = 0;
+  mHasPrevious = false;
+  mPreviousUtility = 0;
+}
+
+/**
+ * @brief Bitrate utility
+ */
+double ABRQoEScore::utilityOf(long bitrate) const {
+  if (mWeights.logUtility && mWeights.logUtilityMinBitrate > 0) {
+    return std::log((double)bitrate / mWeights.logUtilityMinBitrate);
+  }
+  return bitrate / 1000000.0;
+}
+
+/**
+ * @brief Window bucket of nowMs, clearing the buckets that left the window.
+ * Events older than the window are accounted to the oldest bucket.
+ */
+ABRQoEScore::Totals& ABRQoEScore::bucketAt(long long nowMs) {
+  long long idx = nowMs / mBucketDurationMs;
+  if (idx > mNewestBucket) {
+    long long clearFrom = mNewestBucket + 1;
+    if (idx - clearFrom >= WINDOW_BUCKETS) {
+      clearFrom = idx - WINDOW_BUCKETS + 1;
+    }
+    for (long long k = clearFrom; k <= idx; k++) {
+      clearTotals(mBuckets[k % WINDOW_BUCKETS]);
+    }
+    mNewestBucket = idx;
+  } else if (idx <= mNewestBucket - WINDOW_BUCKETS) {
+    idx = mNewestBucket - WINDOW_BUCKETS + 1;
+  }
+  return mBuckets[(idx > 0 ? idx : 0) % WINDOW_BUCKETS];
+}
+
+/**
+ * @brief Zero accumulated terms
+ */
+void ABRQoEScore::clearTotals(Totals& totals) {
+  totals.utility = 0;
+  totals.switchTerm = 0;
+  totals.rebufferTerm = 0;
+  totals.startupTerm = 0;
+  totals.contentDuration = 0;
+  totals.rebufferDuration = 0;
+  totals.switchCount = 0;
+  totals.fragmentCount = 0;
+}
+
+/**
+ * @brief Add accumulated terms
+ */
+void ABRQoEScore::addTotals(Totals& dst, const Totals& src) {
+  dst.utility += src.utility;
+  dst.switchTerm += src.switchTerm;
+  dst.rebufferTerm += src.rebufferTerm;
+  dst.startupTerm += src.startupTerm;
+  dst.contentDuration += src.contentDuration;
+  dst.rebufferDuration += src.rebufferDuration;
+  dst.switchCount += src.switchCount;
+  dst.fragmentCount += src.fragmentCount;
+}
+
+/**
+ * @brief Apply the weights to accumulated terms
+ */
+void ABRQoEScore::toScore(const Totals& totals, Score& score) const {
+  score.utility = totals.utility;
+  score.switchPenalty = mWeights.switchPenalty * totals.switchTerm;
+  score.rebufferPenalty = mWeights.rebufferPenalty * totals.rebufferTerm;
+  score.startupPenalty = mWeights.startupPenalty * totals.startupTerm;
+  score.total = score.utility - score.switchPenalty - score.rebufferPenalty - score.startupPenalty;
+  score.contentDuration = totals.contentDuration;
+  score.rebufferDuration = totals.rebufferDuration;
+  score.switchCount = totals.switchCount;
+  score.fragmentCount = totals.fragmentCount;
+}
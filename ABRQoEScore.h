@@ -0,0 +1,200 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRQoEScore.h
+ * @brief Online QoE score of a playback session
+ ***************************************************/
+
+#ifndef ABR_QOE_SCORE_H
+#define ABR_QOE_SCORE_H
+
+/**
+ * @class ABRQoEScore
+ * @brief Computes the linear QoE model online
+ *
+ *   QoE = sum(q(R) * d) - switchPenalty * sum(|q(R_k) - q(R_k-1)|)
+ *         - rebufferPenalty * stall time - startupPenalty * startup delay
+ *
+ * where R is the bitrate of a fragment, d its duration in seconds and q()
+ * the bitrate utility, either R in Mbps or log(R / minimum bitrate).
+ * The score is kept for the whole session and for a rolling window made
+ * of a fixed number of time buckets, every event is O(1).
+ */
+class ABRQoEScore {
+public:
+  /**
+   * @brief Weights of the QoE terms
+   */
+  struct Weights {
+    /**
+     * @brief Use log(R / logUtilityMinBitrate) as utility instead of R in Mbps
+     */
+    bool logUtility;
+
+    /**
+     * @brief Reference bitrate of the log utility, in bps
+     */
+    long logUtilityMinBitrate;
+
+    /**
+     * @brief Weight of the utility change on each switch
+     */
+    double switchPenalty;
+
+    /**
+     * @brief Weight of each second of stall
+     */
+    double rebufferPenalty;
+
+    /**
+     * @brief Weight of each second of startup delay, 0 to leave it out
+     */
+    double startupPenalty;
+  };
+
+  /**
+   * @brief QoE score and its terms
+   */
+  struct Score {
+    double total;
+    double utility;
+    double switchPenalty;
+    double rebufferPenalty;
+    double startupPenalty;
+    /**
+     * @brief Duration of the reported fragments in seconds
+     */
+    double contentDuration;
+    /**
+     * @brief Stall time in seconds
+     */
+    double rebufferDuration;
+    int switchCount;
+    int fragmentCount;
+  };
+
+  /**
+   * @brief Default length of the rolling window
+   */
+  static const int DEFAULT_WINDOW_MS = 60000;
+
+  /**
+   * @brief Number of buckets of the rolling window
+   */
+  static const int WINDOW_BUCKETS = 12;
+
+  /**
+   * @fn ABRQoEScore
+   */
+  ABRQoEScore();
+
+  /**
+   * @fn setWeights
+   * @param weights QoE weights. The utility function applies to the events
+   * reported afterwards, the penalty weights to the whole score.
+   */
+  void setWeights(const Weights& weights);
+
+  /**
+   * @fn getWeights
+   */
+  const Weights& getWeights() const { return mWeights; }
+
+  /**
+   * @fn setWindow
+   * @brief Set the rolling window length, clears the window
+   *
+   * @param windowMs Window length in ms
+   */
+  void setWindow(long long windowMs);
+
+  /**
+   * @fn onFragment
+   * @brief Account a fragment about to be played
+   *
+   * @param bitrate Bitrate of the fragment in bps
+   * @param durationMs Duration of the fragment in ms
+   * @param nowMs Current time in ms
+   */
+  void onFragment(long bitrate, long durationMs, long long nowMs);
+
+  /**
+   * @fn onStall
+   * @param durationMs Stall duration in ms
+   * @param nowMs Current time in ms
+   */
+  void onStall(long durationMs, long long nowMs);
+
+  /**
+   * @fn onStartup
+   * @param delayMs Startup delay in ms
+   * @param nowMs Current time in ms
+   */
+  void onStartup(long delayMs, long long nowMs);
+
+  /**
+   * @fn getSessionScore
+   * @param[out] score QoE of the session
+   */
+  void getSessionScore(Score& score) const;
+
+  /**
+   * @fn getWindowScore
+   * @param nowMs Current time in ms
+   * @param[out] score QoE of the last window length
+   */
+  void getWindowScore(long long nowMs, Score& score) const;
+
+  /**
+   * @fn reset
+   * @brief Start a new session
+   */
+  void reset();
+
+private:
+  /**
+   * @brief Accumulated terms
+   */
+  struct Totals {
+    double utility;
+    double switchTerm;
+    double rebufferTerm;
+    double startupTerm;
+    double contentDuration;
+    double rebufferDuration;
+    int switchCount;
+    int fragmentCount;
+  };
+
+  double utilityOf(long bitrate) const;
+  Totals& bucketAt(long long nowMs);
+  static void clearTotals(Totals& totals);
+  static void addTotals(Totals& dst, const Totals& src);
+  void toScore(const Totals& totals, Score& score) const;
+
+  Weights mWeights;
+  Totals mSession;
+  Totals mBuckets[WINDOW_BUCKETS];
+  long long mBucketDurationMs;
+  /**
+   * @brief Absolute index (time / bucket duration) of the newest bucket
+   */
+  long long mNewestBucket;
+  bool mHasPrevious;
+  double mPreviousUtility;
+};
+#endif
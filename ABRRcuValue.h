@@ -0,0 +1,197 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRRcuValue.h
+ * @brief Versioned immutable value, read without locks, replaced atomically
+ ***************************************************/
+
+#ifndef ABR_RCU_VALUE_H
+#define ABR_RCU_VALUE_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class ABRRcuValue
+ * @brief Read-copy-update holder of an immutable versioned value
+ *
+ * Readers pin the current snapshot with a Reader, which costs one atomic
+ * increment and decrement of a reader counter, and never wait. publish()
+ * swaps in a new snapshot and frees the previous one once no Reader can
+ * hold it: readers count themselves in one of two counters selected by the
+ * epoch, and the writer flips the epoch and waits for the counter of the
+ * previous epoch to drain. A reader checks that the epoch did not change
+ * while it counted itself, and counts again if it did, so a counter a
+ * writer already waited on never gains a reader. Writers are serialized by
+ * a mutex.
+ *
+ * A Reader must be short lived and must not publish.
+ */
+template <typename T>
+class ABRRcuValue {
+public:
+  /**
+   * @brief Immutable value and its version, 1 for the initial value
+   */
+  struct Snapshot {
+    T value;
+    unsigned version;
+  };
+
+  /**
+   * @class Reader
+   * @brief Pins the current snapshot for the lifetime of the Reader
+   */
+  class Reader {
+  public:
+    explicit Reader(const ABRRcuValue& holder) :
+      mHolder(holder),
+      mEpoch(0),
+      mSnapshot(NULL) {
+      for (;;) {
+        unsigned epoch = mHolder.mEpoch.load(std::memory_order_seq_cst);
+        mEpoch = epoch & 1;
+        mHolder.mReaders[mEpoch].fetch_add(1, std::memory_order_seq_cst);
+        // Counted before the epoch moved on: the next publish waits for us.
+        // Otherwise a publish may already have waited on this counter and a
+        // second one would not, count again in the new epoch.
+        if (mHolder.mEpoch.load(std::memory_order_seq_cst) == epoch) {
+          break;
+        }
+        mHolder.mReaders[mEpoch].fetch_sub(1, std::memory_order_release);
+      }
+      mSnapshot = mHolder.mCurrent.load(std::memory_order_seq_cst);
+    }
+
+    ~Reader() {
+      mHolder.mReaders[mEpoch].fetch_sub(1, std::memory_order_release);
+    }
+
+    const T& operator*() const { return mSnapshot->value; }
+    const T* operator->() const { return &mSnapshot->value; }
+    unsigned version() const { return mSnapshot->version; }
+
+  private:
+    Reader(const Reader&);
+    Reader& operator=(const Reader&);
+
+    const ABRRcuValue& mHolder;
+    unsigned mEpoch;
+    const Snapshot* mSnapshot;
+  };
+
+  /**
+   * @fn ABRRcuValue
+   * @param value Initial value, version 1
+   */
+  explicit ABRRcuValue(const T& value) :
+    mCurrent(new Snapshot(makeSnapshot(value, 1))),
+    mEpoch(0),
+    mWriteMutex() {
+    mReaders[0].store(0, std::memory_order_relaxed);
+    mReaders[1].store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @fn ABRRcuValue
+   * @brief Copy the current snapshot of another holder, with its version
+   */
+  ABRRcuValue(const ABRRcuValue& other) :
+    mCurrent(NULL),
+    mEpoch(0),
+    mWriteMutex() {
+    Reader reader(other);
+    mCurrent.store(new Snapshot(makeSnapshot(*reader, reader.version())), std::memory_order_relaxed);
+    mReaders[0].store(0, std::memory_order_relaxed);
+    mReaders[1].store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @fn operator=
+   * @brief Publish the current value of another holder
+   */
+  ABRRcuValue& operator=(const ABRRcuValue& other) {
+    if (this != &other) {
+      T value;
+      {
+        Reader reader(other);
+        value = *reader;
+      }
+      publish(value);
+    }
+    return *this;
+  }
+
+  ~ABRRcuValue() {
+    delete mCurrent.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @fn publish
+   * @brief Replace the value, waits until no Reader holds the previous one
+   *
+   * @param value New value
+   * @return Version of the new value
+   */
+  unsigned publish(const T& value) {
+    std::lock_guard<std::mutex> lock(mWriteMutex);
+    const Snapshot* previous = mCurrent.load(std::memory_order_relaxed);
+    unsigned version = previous->version + 1;
+    mCurrent.store(new Snapshot(makeSnapshot(value, version)), std::memory_order_seq_cst);
+
+    // Readers of the previous epoch may hold the previous snapshot, newer
+    // readers see the new one
+    unsigned epoch = mEpoch.load(std::memory_order_relaxed);
+    mEpoch.store(epoch + 1, std::memory_order_seq_cst);
+    while (mReaders[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+    delete previous;
+    return version;
+  }
+
+  /**
+   * @fn version
+   * @return Version of the current value
+   */
+  unsigned version() const {
+    Reader reader(*this);
+    return reader.version();
+  }
+
+  /**
+   * @fn get
+   * @return Copy of the current value
+   */
+  T get() const {
+    Reader reader(*this);
+    return *reader;
+  }
+
+private:
+  static Snapshot makeSnapshot(const T& value, unsigned version) {
+    Snapshot snapshot = { value, version };
+    return snapshot;
+  }
+
+  std::atomic<const Snapshot*> mCurrent;
+  mutable std::atomic<int> mReaders[2];
+  std::atomic<unsigned> mEpoch;
+  std::mutex mWriteMutex;
+};
+#endif
@@ -0,0 +1,229 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRSessionPool.cpp
+ * @brief Compact ABR state of many client sessions, for proxy side ABR
+ ***************************************************/
+
+#include "ABRSessionPool.h"
+#include <algorithm>
+
+const int ABRSessionPool::MAX_SESSION_SAMPLES;
+
+/**
+ * @brief Constructor of ABRSessionPool
+ */
+ABRSessionPool::ABRSessionPool(int shardCount, const Config& config) :
+  mConfig(config),
+  mShards(),
+  mLadders(new ABRBatchDecision()),
+  mLadderVersion(0),
+  mLadderMutex() {
+  if (mConfig.cacheLength > MAX_SESSION_SAMPLES) {
+    mConfig.cacheLength = MAX_SESSION_SAMPLES;
+  } else if (mConfig.cacheLength < 1) {
+    mConfig.cacheLength = 1;
+  }
+  for (int i = 0; i < shardCount; i++) {
+    mShards.push_back(std::unique_ptr<Shard>(new Shard(this)));
+  }
+}
+
+/**
+ * @brief Add an immutable ladder, the shards pick up the new ladder set on
+ * their next call
+ */
+int ABRSessionPool::addLadder(const long* bandwidths, int count) {
+  std::lock_guard<std::mutex> lock(mLadderMutex);
+  std::shared_ptr<ABRBatchDecision> ladders(new ABRBatchDecision(*mLadders));
+  int ladderId = ladders->addLadder(bandwidths, count);
+  if (ladderId >= 0) {
+    mLadders = ladders;
+    mLadderVersion.fetch_add(1, std::memory_order_release);
+  }
+  return ladderId;
+}
+
+/**
+ * @brief Constructor of a shard
+ */
+ABRSessionPool::Shard::Shard(ABRSessionPool* pool) :
+  mPool(pool),
+  mLadders(),
+  mLadderVersion(0),
+  mLadderId(),
+  mRung(),
+  mUpCount(),
+  mDownCount(),
+  mEstimate(),
+  mSamples(),
+  mFreeSlots(),
+  mChosen() {
+  std::lock_guard<std::mutex> lock(pool->mLadderMutex);
+  mLadders = pool->mLadders;
+  mLadderVersion = pool->mLadderVersion.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Check a slot holds a session, a released slot has ladder id -1
+ */
+bool ABRSessionPool::Shard::isLive(int slot) const {
+  return slot >= 0 && slot < (int)mLadderId.size() && mLadderId[slot] >= 0;
+}
+
+/**
+ * @brief Take the current ladder set if a ladder was added, the pool lock
+ * is only taken in that case
+ */
+void ABRSessionPool::Shard::refreshLadders() {
+  unsigned version = mPool->mLadderVersion.load(std::memory_order_acquire);
+  if (version != mLadderVersion) {
+    std::lock_guard<std::mutex> lock(mPool->mLadderMutex);
+    mLadders = mPool->mLadders;
+    mLadderVersion = mPool->mLadderVersion.load(std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Create a session
+ */
+int ABRSessionPool::Shard::createSession(int ladderId, int initialRung) {
+  refreshLadders();
+  if (ladderId < 0 || ladderId >= mLadders->getLadderCount()) {
+    return -1;
+  }
+  int rungCount = mLadders->getRungCount(ladderId);
+  initialRung = std::min(std::max(initialRung, 0), rungCount - 1);
+  Samples samples = Samples();
+
+  int slot;
+  if (!mFreeSlots.empty()) {
+    slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+    mLadderId[slot] = ladderId;
+    mRung[slot] = initialRung;
+    mUpCount[slot] = 0;
+    mDownCount[slot] = 0;
+    mEstimate[slot] = -1;
+    mSamples[slot] = samples;
+  } else {
+    slot = static_cast<int>(mLadderId.size());
+    mLadderId.push_back(ladderId);
+    mRung.push_back(initialRung);
+    mUpCount.push_back(0);
+    mDownCount.push_back(0);
+    mEstimate.push_back(-1);
+    mSamples.push_back(samples);
+    mChosen.push_back(initialRung);
+  }
+  return slot;
+}
+
+/**
+ * @brief Release a session
+ */
+void ABRSessionPool::Shard::releaseSession(int slot) {
+  if (!isLive(slot)) {
+    return;
+  }
+  mLadderId[slot] = -1;
+  mFreeSlots.push_back(slot);
+}
+
+/**
+ * @brief Account a download and update the estimate, same steps as
+ * HybridABRManager cache length, cache life and cache outlier updates
+ */
+long ABRSessionPool::Shard::addSample(int slot, long downloadbps, long long nowMs) {
+  if (!isLive(slot)) {
+    return -1;
+  }
+  const Config& config = mPool->mConfig;
+  Samples& samples = mSamples[slot];
+  uint32_t now = (uint32_t)nowMs;
+
+  // Cache length: keep the last cacheLength samples
+  samples.bps[samples.head] = (uint32_t)std::min(std::max(downloadbps, 0L), (long)UINT32_MAX);
+  samples.timeMs[samples.head] = now;
+  samples.head = (uint8_t)((samples.head + 1) % config.cacheLength);
+  if (samples.count < config.cacheLength) {
+    samples.count++;
+  }
+
+  // Cache life: use the samples younger than cacheLife
+  long data[MAX_SESSION_SAMPLES];
+  int dataCount = 0;
+  for (int i = 0; i < samples.count; i++) {
+    if ((uint32_t)(now - samples.timeMs[i]) <= (uint32_t)config.cacheLife) {
+      data[dataCount++] = samples.bps[i];
+    }
+  }
+  if (dataCount == 0) {
+    mEstimate[slot] = -1;
+    return -1;
+  }
+
+  // Cache outlier: average of the samples close to the median
+  std::sort(data, data + dataCount);
+  long medianbps;
+  if (dataCount % 2) {
+    medianbps = data[dataCount / 2];
+  } else {
+    // same median as HybridABRManager::UpdateABRBitrateDataBasedOnCacheOutlier
+    medianbps = (data[dataCount / 2] + data[dataCount / 2] + 1) / 2;
+  }
+  long avg = 0;
+  int kept = 0;
+  for (int i = 0; i < dataCount; i++) {
+    long diffOutlier = data[i] > medianbps ? data[i] - medianbps : medianbps - data[i];
+    if (diffOutlier <= config.cacheOutlier) {
+      avg += data[i];
+      kept++;
+    }
+  }
+  mEstimate[slot] = kept ? avg / kept : -1;
+  return mEstimate[slot];
+}
+
+/**
+ * @brief Decision of one session
+ */
+int ABRSessionPool::Shard::decide(int slot) {
+  if (!isLive(slot)) {
+    return -1;
+  }
+  mRung[slot] = mLadders->decideOne(mLadderId[slot], mRung[slot], mEstimate[slot],
+    mPool->mConfig.nwConsistency, mUpCount[slot], mDownCount[slot]);
+  return mRung[slot];
+}
+
+/**
+ * @brief Decision of every live session
+ */
+void ABRSessionPool::Shard::decideAll() {
+  int count = static_cast<int>(mLadderId.size());
+  if (count == 0) {
+    return;
+  }
+  mLadders->decide(count, &mLadderId[0], &mRung[0], &mEstimate[0], mPool->mConfig.nwConsistency,
+    &mUpCount[0], &mDownCount[0], &mChosen[0]);
+  for (int i = 0; i < count; i++) {
+    if (mChosen[i] >= 0) {
+      mRung[i] = mChosen[i];
+    }
+  }
+}
@@ -0,0 +1,239 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRSessionPool.h
+ * @brief Compact ABR state of many client sessions, for proxy side ABR
+ ***************************************************/
+
+#ifndef ABR_SESSION_POOL_H
+#define ABR_SESSION_POOL_H
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ABRBatchDecision.h"
+
+/**
+ * @class ABRSessionPool
+ * @brief ABR decisions on behalf of many clients (eAAMP_BITRATE_CHANGE_BY_FOG_ABR)
+ *
+ * Ladders are shared and immutable, each client session only keeps its
+ * ladder id, current rung, consistency counters and the bandwidth estimator
+ * samples, stored contiguously in a shard. Sessions are split in shards, each
+ * shard is owned by one worker thread: creating, updating and deciding for a
+ * session is done by its owner thread without any lock.
+ *
+ * The bandwidth estimate of a session is the one of HybridABRManager: the
+ * last cacheLength samples younger than cacheLife, averaged after dropping
+ * the ones further than cacheOutlier from the median.
+ */
+class ABRSessionPool {
+public:
+  /**
+   * @brief Maximum number of estimator samples of a session
+   */
+  static const int MAX_SESSION_SAMPLES = 4;
+
+  /**
+   * @brief Estimator and decision configuration, shared by all sessions
+   */
+  struct Config {
+    /**
+     * @brief Age in ms after which a sample is dropped
+     */
+    int cacheLife;
+
+    /**
+     * @brief Number of samples kept, at most MAX_SESSION_SAMPLES
+     */
+    int cacheLength;
+
+    /**
+     * @brief Samples further than this from the median are dropped, in bps
+     */
+    int cacheOutlier;
+
+    /**
+     * @brief Number of consecutive one rung moves needed to switch
+     */
+    int nwConsistency;
+  };
+
+  /**
+   * @class Shard
+   * @brief Sessions owned by one worker thread. Not thread safe, every call
+   * must be made by the owner thread.
+   */
+  class Shard {
+  public:
+    /**
+     * @fn createSession
+     * @param ladderId Ladder of the session
+     * @param initialRung Initial rung
+     * @return Session slot in this shard, -1 for an unknown ladder
+     */
+    int createSession(int ladderId, int initialRung);
+
+    /**
+     * @fn releaseSession
+     * @param slot Session slot, reused by a later session
+     */
+    void releaseSession(int slot);
+
+    /**
+     * @fn addSample
+     * @brief Account a completed download of a session
+     *
+     * @param slot Session slot
+     * @param downloadbps Measured download speed in bps
+     * @param nowMs Current time in ms
+     * @return Updated bandwidth estimate in bps, -1 if none or for a
+     * released or unknown slot
+     */
+    long addSample(int slot, long downloadbps, long long nowMs);
+
+    /**
+     * @fn decide
+     * @brief Ramp up/down decision of a session, updates its current rung
+     *
+     * @param slot Session slot
+     * @return Chosen rung, -1 for a released or unknown slot
+     */
+    int decide(int slot);
+
+    /**
+     * @fn decideAll
+     * @brief Ramp up/down decision of every session of the shard, with the
+     * batch kernel. Updates the current rungs.
+     */
+    void decideAll();
+
+    /**
+     * @fn getRung
+     * @param slot Session slot
+     * @return Current rung
+     */
+    int getRung(int slot) const { return mRung[slot]; }
+
+    /**
+     * @fn getBandwidth
+     * @param slot Session slot
+     * @return Bandwidth of the current rung in bps
+     */
+    long getBandwidth(int slot) const { return mLadders->getRungBandwidth(mLadderId[slot], mRung[slot]); }
+
+    /**
+     * @fn getEstimate
+     * @param slot Session slot
+     * @return Bandwidth estimate in bps, -1 if none
+     */
+    long getEstimate(int slot) const { return mEstimate[slot]; }
+
+    /**
+     * @fn getSessionCount
+     * @return Number of live sessions
+     */
+    int getSessionCount() const { return static_cast<int>(mLadderId.size() - mFreeSlots.size()); }
+
+  private:
+    friend class ABRSessionPool;
+
+    /**
+     * @brief Estimator samples of a session
+     */
+    struct Samples {
+      uint32_t bps[MAX_SESSION_SAMPLES];
+      uint32_t timeMs[MAX_SESSION_SAMPLES];
+      uint8_t head;
+      uint8_t count;
+    };
+
+    explicit Shard(ABRSessionPool* pool);
+    bool isLive(int slot) const;
+    void refreshLadders();
+
+    ABRSessionPool* mPool;
+    /**
+     * @brief Ladders as of mLadderVersion
+     */
+    std::shared_ptr<const ABRBatchDecision> mLadders;
+    unsigned mLadderVersion;
+
+    /**
+     * @brief Session state, indexed by slot. A free slot has ladder id -1.
+     */
+    std::vector<int> mLadderId;
+    std::vector<int> mRung;
+    std::vector<int> mUpCount;
+    std::vector<int> mDownCount;
+    std::vector<long> mEstimate;
+    std::vector<Samples> mSamples;
+    std::vector<int> mFreeSlots;
+    std::vector<int> mChosen;
+  };
+
+  /**
+   * @fn ABRSessionPool
+   * @param shardCount Number of shards, usually one per worker thread
+   * @param config Estimator and decision configuration
+   */
+  ABRSessionPool(int shardCount, const Config& config);
+
+  /**
+   * @fn addLadder
+   * @brief Add an immutable ladder, may be called from any thread
+   *
+   * @param bandwidths Profile bandwidths in bps
+   * @param count Number of bandwidths
+   * @return Ladder id, -1 if the ladder is empty
+   */
+  int addLadder(const long* bandwidths, int count);
+
+  /**
+   * @fn getShardCount
+   */
+  int getShardCount() const { return static_cast<int>(mShards.size()); }
+
+  /**
+   * @fn getShard
+   * @param index Shard index
+   * @return Shard, to be used by its owner thread only
+   */
+  Shard& getShard(int index) { return *mShards[index]; }
+
+  /**
+   * @fn getConfig
+   */
+  const Config& getConfig() const { return mConfig; }
+
+private:
+  ABRSessionPool(const ABRSessionPool&);
+  ABRSessionPool& operator=(const ABRSessionPool&);
+
+  Config mConfig;
+  std::vector<std::unique_ptr<Shard> > mShards;
+
+  /**
+   * @brief Current ladders, replaced (copy on write) by addLadder
+   */
+  std::shared_ptr<const ABRBatchDecision> mLadders;
+  std::atomic<unsigned> mLadderVersion;
+  std::mutex mLadderMutex;
+};
+#endif
@@ -0,0 +1,317 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRSharedBandwidth.cpp
+ * @brief Link bandwidth estimate shared by the player processes of a device
+ ***************************************************/
+
+#include "ABRSharedBandwidth.h"
+#include "ABRManager.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Segment magic ("ABRS")
+ */
+static const uint32_t SHARED_BANDWIDTH_MAGIC = 0x53524241;
+
+/**
+ * @brief Segment layout version, bump on any layout change
+ */
+static const uint32_t SHARED_BANDWIDTH_VERSION = 2;
+
+const int ABRSharedBandwidth::HISTORY_SIZE;
+const int ABRSharedBandwidth::MAX_READ_RETRIES;
+
+/**
+ * @brief Layout of the mapped segment. Every field written after the
+ * initialization is atomic, the lock-free atomics work across processes.
+ */
+struct ABRSharedBandwidth::Layout {
+  uint32_t magic;
+  uint32_t version;
+
+  /**
+   * @brief Lock word of the publisher holding the lock, 0 if none
+   */
+  std::atomic<uint64_t> writer;
+
+  /**
+   * @brief Seqlock sequence, odd while an update is in progress
+   */
+  std::atomic<uint32_t> sequence;
+
+  std::atomic<int64_t> bandwidth;
+  std::atomic<int64_t> averageBandwidth;
+  std::atomic<int64_t> updatedTimeMs;
+  std::atomic<int32_t> sampleCount;
+  std::atomic<int32_t> publisherPid;
+
+  /**
+   * @brief History ring, the next sample goes to historyHead
+   */
+  std::atomic<uint32_t> historyHead;
+  std::atomic<uint32_t> historyCount;
+  std::atomic<int64_t> historyBandwidth[HISTORY_SIZE];
+  std::atomic<int64_t> historyTimeMs[HISTORY_SIZE];
+};
+
+/**
+ * @brief Start time of a process in clock ticks since boot (low 32 bits),
+ * 0 if unknown
+ */
+static uint32_t processStartTime(int pid) {
+  char path[32];
+  snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    return 0;
+  }
+  char buffer[512];
+  size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+  fclose(file);
+  buffer[length] = '\0';
+  // The command name may hold spaces, the fields restart after the last ')'
+  const char* field = strrchr(buffer, ')');
+  // starttime is the field 22, the state after ')' is the field 3
+  for (int i = 3; i <= 22 && field; i++) {
+    field = strchr(field + 1, ' ');
+  }
+  return field ? (uint32_t)strtoull(field + 1, NULL, 10) : 0;
+}
+
+/**
+ * @brief Check the publisher of a lock word still runs
+ */
+static bool isWriterAlive(uint64_t writer) {
+  int pid = (int)(uint32_t)writer;
+  uint32_t startTime = (uint32_t)(writer >> 32);
+  if (kill(pid, 0) != 0 && errno == ESRCH) {
+    return false;
+  }
+  // Another start time is another process, the owner died and its pid was reused
+  uint32_t currentStartTime = processStartTime(pid);
+  return startTime == 0 || currentStartTime == 0 || currentStartTime == startTime;
+}
+
+/**
+ * @brief Constructor of ABRSharedBandwidth
+ */
+ABRSharedBandwidth::ABRSharedBandwidth() :
+  mLayout(NULL),
+  mFd(-1),
+  mPid((int)getpid()),
+  mWriterId(((uint64_t)processStartTime(mPid) << 32) | (uint32_t)mPid) {
+}
+
+/**
+ * @brief Destructor of ABRSharedBandwidth
+ */
+ABRSharedBandwidth::~ABRSharedBandwidth() {
+  close();
+}
+
+/**
+ * @brief Map the segment, initialize it if it is new or of another layout
+ */
+bool ABRSharedBandwidth::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    ABRManager::logprintf("%s:%d Failed to open shared bandwidth %s\n", __FUNCTION__, __LINE__, path.c_str());
+    return false;
+  }
+
+  // Serialize the initialization with the other processes opening the segment
+  flock(fd, LOCK_EX);
+  struct stat st;
+  bool reset = (fstat(fd, &st) != 0 || st.st_size != (off_t)sizeof(Layout));
+  if (reset && ftruncate(fd, sizeof(Layout)) != 0) {
+    ABRManager::logprintf("%s:%d Failed to size shared bandwidth %s\n", __FUNCTION__, __LINE__, path.c_str());
+    flock(fd, LOCK_UN);
+    ::close(fd);
+    return false;
+  }
+
+  void* addr = mmap(NULL, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    ABRManager::logprintf("%s:%d Failed to map shared bandwidth %s\n", __FUNCTION__, __LINE__, path.c_str());
+    flock(fd, LOCK_UN);
+    ::close(fd);
+    return false;
+  }
+
+  Layout* layout = static_cast<Layout*>(addr);
+  if (reset || layout->magic != SHARED_BANDWIDTH_MAGIC || layout->version != SHARED_BANDWIDTH_VERSION) {
+    // All zero is a valid empty segment for the atomics
+    memset(static_cast<void*>(layout), 0, sizeof(Layout));
+    layout->version = SHARED_BANDWIDTH_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    layout->magic = SHARED_BANDWIDTH_MAGIC;
+  }
+  flock(fd, LOCK_UN);
+
+  mFd = fd;
+  mLayout = layout;
+  return true;
+}
+
+/**
+ * @brief Unmap the segment
+ */
+void ABRSharedBandwidth::close() {
+  if (mLayout) {
+    munmap(static_cast<void*>(mLayout), sizeof(Layout));
+    mLayout = NULL;
+  }
+  if (mFd >= 0) {
+    ::close(mFd);
+    mFd = -1;
+  }
+}
+
+/**
+ * @brief Take the publisher lock, from a dead owner if needed. Never waits.
+ */
+bool ABRSharedBandwidth::lock() {
+  uint64_t owner = 0;
+  if (mLayout->writer.compare_exchange_strong(owner, mWriterId, std::memory_order_acquire)) {
+    return true;
+  }
+  // A crashed publisher leaves its lock word, and possibly an odd sequence
+  if (owner != mWriterId && !isWriterAlive(owner)) {
+    return mLayout->writer.compare_exchange_strong(owner, mWriterId, std::memory_order_acquire);
+  }
+  return false;
+}
+
+/**
+ * @brief Release the publisher lock
+ */
+void ABRSharedBandwidth::unlock() {
+  mLayout->writer.store(0, std::memory_order_release);
+}
+
+/**
+ * @brief Publish a sample if it is the freshest one
+ */
+bool ABRSharedBandwidth::publish(long bandwidth, long long timeMs) {
+  if (!mLayout || bandwidth <= 0 || !lock()) {
+    return false;
+  }
+  Layout* layout = mLayout;
+  if (timeMs < layout->updatedTimeMs.load(std::memory_order_relaxed)) {
+    unlock();
+    return false;
+  }
+
+  uint32_t sequence = layout->sequence.load(std::memory_order_relaxed);
+  // An odd sequence is the torn update of a dead publisher, overwritten now
+  sequence |= 1;
+  layout->sequence.store(sequence, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  int32_t sampleCount = layout->sampleCount.load(std::memory_order_relaxed);
+  int64_t average = layout->averageBandwidth.load(std::memory_order_relaxed);
+  average = (sampleCount > 0 && average > 0) ? (average * 3 + bandwidth) / 4 : bandwidth;
+  layout->bandwidth.store(bandwidth, std::memory_order_relaxed);
+  layout->averageBandwidth.store(average, std::memory_order_relaxed);
+  layout->updatedTimeMs.store(timeMs, std::memory_order_relaxed);
+  layout->sampleCount.store(sampleCount + 1, std::memory_order_relaxed);
+  layout->publisherPid.store(mPid, std::memory_order_relaxed);
+
+  uint32_t head = layout->historyHead.load(std::memory_order_relaxed) % HISTORY_SIZE;
+  uint32_t count = layout->historyCount.load(std::memory_order_relaxed);
+  layout->historyBandwidth[head].store(bandwidth, std::memory_order_relaxed);
+  layout->historyTimeMs[head].store(timeMs, std::memory_order_relaxed);
+  layout->historyHead.store((head + 1) % HISTORY_SIZE, std::memory_order_relaxed);
+  layout->historyCount.store(count < (uint32_t)HISTORY_SIZE ? count + 1 : count, std::memory_order_relaxed);
+
+  layout->sequence.store(sequence + 1, std::memory_order_release);
+  unlock();
+  return true;
+}
+
+/**
+ * @brief Read the latest estimate, lock-free
+ */
+bool ABRSharedBandwidth::read(Estimate& estimate) const {
+  if (!mLayout) {
+    return false;
+  }
+  const Layout* layout = mLayout;
+  for (int retry = 0; retry < MAX_READ_RETRIES; retry++) {
+    uint32_t before = layout->sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    estimate.bandwidth = (long)layout->bandwidth.load(std::memory_order_relaxed);
+    estimate.averageBandwidth = (long)layout->averageBandwidth.load(std::memory_order_relaxed);
+    estimate.updatedTimeMs = layout->updatedTimeMs.load(std::memory_order_relaxed);
+    estimate.sampleCount = layout->sampleCount.load(std::memory_order_relaxed);
+    estimate.publisherPid = layout->publisherPid.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (layout->sequence.load(std::memory_order_relaxed) == before) {
+      return estimate.sampleCount > 0;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Read the recent samples, lock-free
+ */
+int ABRSharedBandwidth::readHistory(Sample* samples, int maxSamples) const {
+  if (!mLayout || maxSamples <= 0) {
+    return 0;
+  }
+  const Layout* layout = mLayout;
+  for (int retry = 0; retry < MAX_READ_RETRIES; retry++) {
+    uint32_t before = layout->sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    uint32_t head = layout->historyHead.load(std::memory_order_relaxed) % HISTORY_SIZE;
+    int count = (int)std::min(layout->historyCount.load(std::memory_order_relaxed), (uint32_t)HISTORY_SIZE);
+    count = std::min(count, maxSamples);
+    for (int i = 0; i < count; i++) {
+      uint32_t slot = (head + HISTORY_SIZE - count + i) % HISTORY_SIZE;
+      samples[i].bandwidth = (long)layout->historyBandwidth[slot].load(std::memory_order_relaxed);
+      samples[i].timeMs = layout->historyTimeMs[slot].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (layout->sequence.load(std::memory_order_relaxed) == before) {
+      return count;
+    }
+  }
+  return 0;
+}
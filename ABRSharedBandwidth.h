@@ -0,0 +1,178 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRSharedBandwidth.h
+ * @brief Link bandwidth estimate shared by the player processes of a device
+ ***************************************************/
+
+#ifndef ABR_SHARED_BANDWIDTH_H
+#define ABR_SHARED_BANDWIDTH_H
+
+#include <string>
+#include <stdint.h>
+
+/**
+ * @class ABRSharedBandwidth
+ * @brief Shared memory segment holding the latest link estimate and its
+ * recent history, so that a player process starting next to running ones
+ * (eg. a preload or an ads player) starts at the right profile
+ *
+ * Readers never lock: the segment is a seqlock, a reader copies the
+ * estimate and retries if the sequence was odd (update in progress) or
+ * changed meanwhile. Publishers take a lock word holding their pid and
+ * process start time, a publisher finding the lock held by a dead process
+ * takes it over and completes the torn update. Until then, reads fail after
+ * MAX_READ_RETRIES retries. A sample older than the shared estimate is
+ * dropped, so the process with the freshest samples wins.
+ *
+ * The start time tells a reused pid from its dead owner. Pids are only
+ * meaningful in one pid namespace: every process sharing a segment must be
+ * in the same one (not in separate containers), otherwise a live publisher
+ * can be taken for a dead one. The start time is read from /proc, without
+ * it only the pid is checked.
+ *
+ * The segment is a file mapped by every process, in a tmpfs such as
+ * /dev/shm so that it does not outlive a reboot.
+ */
+class ABRSharedBandwidth {
+public:
+  /**
+   * @brief Number of samples of the history
+   */
+  static const int HISTORY_SIZE = 16;
+
+  /**
+   * @brief Latest shared estimate
+   */
+  struct Estimate {
+    /**
+     * @brief Latest bandwidth estimate in bps
+     */
+    long bandwidth;
+
+    /**
+     * @brief Smoothed bandwidth estimate in bps
+     */
+    long averageBandwidth;
+
+    /**
+     * @brief Wall clock time of the latest sample in ms since epoch
+     */
+    long long updatedTimeMs;
+
+    /**
+     * @brief Number of samples published since the segment was created
+     */
+    int sampleCount;
+
+    /**
+     * @brief Pid of the process which published the latest sample
+     */
+    int publisherPid;
+  };
+
+  /**
+   * @brief Sample of the history
+   */
+  struct Sample {
+    long bandwidth;
+    long long timeMs;
+  };
+
+  /**
+   * @fn ABRSharedBandwidth
+   */
+  ABRSharedBandwidth();
+
+  /**
+   * @fn ~ABRSharedBandwidth
+   */
+  ~ABRSharedBandwidth();
+
+  /**
+   * @fn open
+   *
+   * @param path Path of the segment, eg. /dev/shm/abr-bandwidth, created if
+   * it doesn't exist
+   * @return true if the segment is mapped
+   */
+  bool open(const std::string& path);
+
+  /**
+   * @fn close
+   * @brief Unmap the segment, it stays for the other processes
+   */
+  void close();
+
+  /**
+   * @fn isOpen
+   * @return true if a segment is mapped
+   */
+  bool isOpen() const { return mLayout != NULL; }
+
+  /**
+   * @fn publish
+   * @brief Publish a sample, without waiting: the sample is dropped if
+   * another live process is publishing or has a fresher one
+   *
+   * @param bandwidth Bandwidth estimate in bps
+   * @param timeMs Wall clock time of the sample in ms since epoch
+   * @return true if the sample was published
+   */
+  bool publish(long bandwidth, long long timeMs);
+
+  /**
+   * @fn read
+   * @param[out] estimate Latest shared estimate
+   * @return true if an estimate was read, false if none was published or an
+   * update kept the segment busy
+   */
+  bool read(Estimate& estimate) const;
+
+  /**
+   * @fn readHistory
+   * @param[out] samples Recent samples, oldest first
+   * @param maxSamples Size of samples
+   * @return Number of samples copied, 0 if none could be read
+   */
+  int readHistory(Sample* samples, int maxSamples) const;
+
+private:
+  struct Layout;
+
+  ABRSharedBandwidth(const ABRSharedBandwidth&);
+  ABRSharedBandwidth& operator=(const ABRSharedBandwidth&);
+
+  bool lock();
+  void unlock();
+
+  /**
+   * @brief Reads retried before giving up on a busy segment
+   */
+  static const int MAX_READ_RETRIES = 64;
+
+  Layout* mLayout;
+  int mFd;
+  int mPid;
+
+  /**
+   * @brief Lock word of this process, start time in the high 32 bits and
+   * pid in the low ones
+   */
+  uint64_t mWriterId;
+};
+#endif
@@ -0,0 +1,157 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRThroughputAggregator.cpp
+ * @brief Link throughput of concurrent downloads
+ ***************************************************/
+
+#include "ABRThroughputAggregator.h"
+
+const int ABRThroughputAggregator::MAX_TRANSFERS;
+const long long ABRThroughputAggregator::DEFAULT_MAX_PERIOD_MS;
+
+/**
+ * @brief Constructor of ABRThroughputAggregator
+ */
+ABRThroughputAggregator::ABRThroughputAggregator() :
+  mActiveCount(0),
+  mPeriodStartMs(0),
+  mPeriodBytes(0),
+  mMaxPeriodMs(DEFAULT_MAX_PERIOD_MS),
+  mMutex() {
+  for (int i = 0; i < MAX_TRANSFERS; i++) {
+    mTransfers[i].active = false;
+    mTransfers[i].progressBytes = 0;
+    mTransfers[i].countedBytes = 0;
+  }
+}
+
+/**
+ * @brief Copy constructor of ABRThroughputAggregator
+ */
+ABRThroughputAggregator::ABRThroughputAggregator(const ABRThroughputAggregator& other) :
+  mMutex() {
+  copyFrom(other);
+}
+
+/**
+ * @brief Assignment of ABRThroughputAggregator
+ */
+ABRThroughputAggregator& ABRThroughputAggregator::operator=(const ABRThroughputAggregator& other) {
+  if (this != &other) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    copyFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Copy the state of other
+ */
+void ABRThroughputAggregator::copyFrom(const ABRThroughputAggregator& other) {
+  std::lock_guard<std::mutex> lock(other.mMutex);
+  for (int i = 0; i < MAX_TRANSFERS; i++) {
+    mTransfers[i] = other.mTransfers[i];
+  }
+  mActiveCount = other.mActiveCount;
+  mPeriodStartMs = other.mPeriodStartMs;
+  mPeriodBytes = other.mPeriodBytes;
+  mMaxPeriodMs = other.mMaxPeriodMs;
+}
+
+/**
+ * @brief Set the duration after which a busy period is cut
+ */
+void ABRThroughputAggregator::setMaxPeriod(long long maxPeriodMs) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mMaxPeriodMs = maxPeriodMs;
+}
+
+/**
+ * @brief A transfer starts, and a busy period if the link was idle
+ */
+int ABRThroughputAggregator::begin(long long nowMs) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (int i = 0; i < MAX_TRANSFERS; i++) {
+    Transfer& transfer = mTransfers[i];
+    if (!transfer.active) {
+      if (mActiveCount == 0) {
+        mPeriodStartMs = nowMs;
+        mPeriodBytes = 0;
+      }
+      transfer.active = true;
+      transfer.progressBytes = 0;
+      transfer.countedBytes = 0;
+      mActiveCount++;
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Bytes received so far by a transfer
+ */
+void ABRThroughputAggregator::progress(int transferId, long long bytesSoFar) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (transferId >= 0 && transferId < MAX_TRANSFERS && mTransfers[transferId].active) {
+    mTransfers[transferId].progressBytes = bytesSoFar;
+  }
+}
+
+/**
+ * @brief A transfer ends, the busy period ends with the last active transfer
+ */
+long ABRThroughputAggregator::end(int transferId, long long nowMs, long long bytes, long long& periodBytes) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (transferId < 0 || transferId >= MAX_TRANSFERS || !mTransfers[transferId].active) {
+    return -1;
+  }
+  Transfer& transfer = mTransfers[transferId];
+  mPeriodBytes += bytes - transfer.countedBytes;
+  transfer.active = false;
+  mActiveCount--;
+
+  long long periodMs = nowMs - mPeriodStartMs;
+  if (mActiveCount > 0 && periodMs < mMaxPeriodMs) {
+    return -1;
+  }
+  if (mActiveCount > 0) {
+    // Cut the busy period, the active transfers start the next one with
+    // what they received so far accounted
+    for (int i = 0; i < MAX_TRANSFERS; i++) {
+      Transfer& active = mTransfers[i];
+      if (active.active && active.progressBytes > active.countedBytes) {
+        mPeriodBytes += active.progressBytes - active.countedBytes;
+        active.countedBytes = active.progressBytes;
+      }
+    }
+  }
+  periodBytes = mPeriodBytes;
+  long throughput = periodMs > 0 ? (long)(mPeriodBytes * 8000 / periodMs) : -1;
+  mPeriodStartMs = nowMs;
+  mPeriodBytes = 0;
+  return throughput;
+}
+
+/**
+ * @brief Number of active transfers
+ */
+int ABRThroughputAggregator::getActiveCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mActiveCount;
+}
@@ -0,0 +1,136 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRThroughputAggregator.h
+ * @brief Link throughput of concurrent downloads
+ ***************************************************/
+
+#ifndef ABR_THROUGHPUT_AGGREGATOR_H
+#define ABR_THROUGHPUT_AGGREGATOR_H
+
+#include <mutex>
+
+/**
+ * @class ABRThroughputAggregator
+ * @brief Measures the link throughput over the busy periods of the link
+ * instead of per transfer
+ *
+ * When audio, video and subtitle fragments, or several video fragments,
+ * download in parallel, each transfer only gets a share of the link and its
+ * own rate underreports the link. A busy period starts when a transfer
+ * starts on an idle link and ends when the last active transfer ends: the
+ * union of the activity intervals. Its throughput is the bytes of all its
+ * transfers over its duration.
+ *
+ * A link that never goes idle is cut every maxPeriodMs at a transfer end,
+ * the active transfers then count the bytes they reported with progress().
+ *
+ * Thread safe, transfers are usually reported by several download threads.
+ */
+class ABRThroughputAggregator {
+public:
+  /**
+   * @brief Maximum number of concurrent transfers
+   */
+  static const int MAX_TRANSFERS = 8;
+
+  /**
+   * @brief Default maximum duration of a busy period, in ms
+   */
+  static const long long DEFAULT_MAX_PERIOD_MS = 2000;
+
+  /**
+   * @fn ABRThroughputAggregator
+   */
+  ABRThroughputAggregator();
+
+  /**
+   * @fn ABRThroughputAggregator
+   * @brief Copy the state of another aggregator
+   */
+  ABRThroughputAggregator(const ABRThroughputAggregator& other);
+
+  /**
+   * @fn operator=
+   * @brief Copy the state of another aggregator
+   */
+  ABRThroughputAggregator& operator=(const ABRThroughputAggregator& other);
+
+  /**
+   * @fn setMaxPeriod
+   * @param maxPeriodMs Duration after which a busy period is cut, in ms
+   */
+  void setMaxPeriod(long long maxPeriodMs);
+
+  /**
+   * @fn begin
+   * @brief A transfer starts
+   *
+   * @param nowMs Current time in ms
+   * @return Transfer id, -1 if MAX_TRANSFERS transfers are active
+   */
+  int begin(long long nowMs);
+
+  /**
+   * @fn progress
+   * @param transferId Id returned by begin
+   * @param bytesSoFar Bytes received so far by the transfer
+   */
+  void progress(int transferId, long long bytesSoFar);
+
+  /**
+   * @fn end
+   * @brief A transfer ends, completed or aborted
+   *
+   * @param transferId Id returned by begin
+   * @param nowMs Current time in ms
+   * @param bytes Bytes received by the transfer
+   * @param[out] periodBytes Bytes of the busy period, if it ended
+   * @return Throughput of the busy period in bps if this transfer ended it,
+   * -1 otherwise
+   */
+  long end(int transferId, long long nowMs, long long bytes, long long& periodBytes);
+
+  /**
+   * @fn getActiveCount
+   * @return Number of active transfers
+   */
+  int getActiveCount() const;
+
+private:
+  /**
+   * @brief Transfer state
+   */
+  struct Transfer {
+    bool active;
+    long long progressBytes;
+    /**
+     * @brief Bytes already accounted in a previous busy period
+     */
+    long long countedBytes;
+  };
+
+  void copyFrom(const ABRThroughputAggregator& other);
+
+  Transfer mTransfers[MAX_TRANSFERS];
+  int mActiveCount;
+  long long mPeriodStartMs;
+  long long mPeriodBytes;
+  long long mMaxPeriodMs;
+  mutable std::mutex mMutex;
+};
+#endif
@@ -0,0 +1,526 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file FixedABRManager.h
+ * @brief Fixed-capacity, heap-free variant of ABRManager
+ ***************************************************/
+
+#ifndef FIXED_ABR_MANAGER_H
+#define FIXED_ABR_MANAGER_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include "ABRManager.h"
+
+/**
+ * @class FixedABRManager
+ * @brief ABRManager with inline storage sized at compile time
+ *
+ * Offers the query API of ABRManager, with the same results, for ladders of
+ * at most MaxProfiles profiles over at most MaxPeriods periods. Periods are
+ * looked up by a hash of their period-Id, then by the period-Id itself, kept
+ * in a fixed-size array; profiles sorted by bandwidth are kept as small index
+ * arrays. Nothing is allocated on ladder build, on decisions or on teardown;
+ * addProfile() fails once the capacity is reached or for a period-Id longer
+ * than MaxPeriodIdLength.
+ *
+ * @tparam MaxProfiles Max number of profiles (<= 255)
+ * @tparam MaxPeriods Max number of distinct period-Ids
+ * @tparam MaxPeriodIdLength Max length of a period-Id
+ */
+template <int MaxProfiles = 16, int MaxPeriods = 4, int MaxPeriodIdLength = 63>
+class FixedABRManager {
+  static_assert(MaxProfiles > 0 && MaxProfiles <= 255, "profile indexes are stored in 8 bits");
+  static_assert(MaxPeriods > 0, "at least one period is needed");
+  static_assert(MaxPeriodIdLength >= 0, "period-Id length cannot be negative");
+
+public:
+  /**
+   * @brief Invalid profile index
+   */
+  static const int INVALID_PROFILE = ABRManager::INVALID_PROFILE;
+
+  /**
+   * @fn hashPeriodId
+   * @brief FNV-1a hash of a period-Id, usable in constant expressions
+   */
+  static constexpr uint32_t hashPeriodId(const char* periodId, uint32_t hash = 2166136261u) {
+    return *periodId ? hashPeriodId(periodId + 1, (hash ^ (unsigned char)*periodId) * 16777619u) : hash;
+  }
+
+  /**
+   * @fn FixedABRManager
+   */
+  FixedABRManager() :
+    mProfileCount(0),
+    mPeriodCount(0),
+    mLowestIframeProfile(INVALID_PROFILE),
+    mDesiredIframeProfile(0),
+    mDefaultInitBitrate(DEFAULT_BITRATE),
+    mDefaultIframeBitrate(0),
+    mAbrProfileChangeUpCount(0),
+    mAbrProfileChangeDownCount(0) {
+  }
+
+  /**
+   * @fn capacity
+   * @return Max number of profiles
+   */
+  static constexpr int capacity() { return MaxProfiles; }
+
+  /**
+   * @fn getProfileCount
+   * @return The number of profiles
+   */
+  int getProfileCount() const { return mProfileCount; }
+
+  /**
+   * @fn addProfile
+   * @param profile The profile info
+   * @return false if the profile or period capacity is exceeded
+   */
+  bool addProfile(const ABRManager::ProfileInfo& profile) {
+    return addProfile(profile.isIframeTrack, profile.bandwidthBitsPerSecond, profile.width, profile.height,
+      profile.periodId.c_str(), profile.userData);
+  }
+
+  /**
+   * @fn addProfile
+   * @param isIframeTrack Is iframe track
+   * @param bandwidthBitsPerSecond Bitrate
+   * @param width Width of resolution
+   * @param height Height of resolution
+   * @param periodId Period-Id of the profile
+   * @param userData profileIndex or PeriodIndex
+   * @return false if the profile or period capacity is exceeded
+   */
+  bool addProfile(bool isIframeTrack, long bandwidthBitsPerSecond, int width, int height, const char* periodId, int userData) {
+    if (mProfileCount >= MaxProfiles) {
+      return false;
+    }
+    int period = 0;
+    if (!isIframeTrack) {
+      period = findPeriod(periodId);
+      if (period < 0) {
+        if (mPeriodCount >= MaxPeriods || strlen(periodId) > (size_t)MaxPeriodIdLength) {
+          return false;
+        }
+        period = mPeriodCount++;
+        mPeriodHash[period] = hashPeriodId(periodId);
+        strcpy(mPeriodId[period], periodId);
+        mSortedCount[period] = 0;
+      }
+    }
+    int idx = mProfileCount++;
+    mBandwidth[idx] = bandwidthBitsPerSecond;
+    mIsIframe[idx] = isIframeTrack;
+    mWidth[idx] = width;
+    mHeight[idx] = height;
+    mUserData[idx] = userData;
+    if (!isIframeTrack) {
+      insertSorted(period, idx);
+    }
+    return true;
+  }
+
+  /**
+   * @fn clearProfiles
+   */
+  void clearProfiles() {
+    mProfileCount = 0;
+    mPeriodCount = 0;
+  }
+
+  /**
+   * @fn updateProfile
+   * @brief Update the lowest / desired iframe profile index, see ABRManager::updateProfile
+   */
+  void updateProfile() {
+    long iframeBandwidth[MaxProfiles];
+    int iframeIdx[MaxProfiles];
+    int iframeTrackIdx = -1;
+    bool is4K = false;
+
+    // Construct the iframe track info, sorted by bandwidth ascendingly (stable)
+    for (int i = 0; i < mProfileCount; i++) {
+      if (mIsIframe[i]) {
+        int pos = ++iframeTrackIdx;
+        while (pos > 0 && iframeBandwidth[pos - 1] > mBandwidth[i]) {
+          iframeBandwidth[pos] = iframeBandwidth[pos - 1];
+          iframeIdx[pos] = iframeIdx[pos - 1];
+          pos--;
+        }
+        iframeBandwidth[pos] = mBandwidth[i];
+        iframeIdx[pos] = i;
+      }
+    }
+    if (iframeTrackIdx < 0) {
+      return;
+    }
+
+    int highestProfileIdx = iframeIdx[iframeTrackIdx];
+    if (mHeight[highestProfileIdx] > HEIGHT_4K || mWidth[highestProfileIdx] > WIDTH_4K) {
+      is4K = true;
+    }
+
+    if (mDefaultIframeBitrate > 0) {
+      mLowestIframeProfile = mDesiredIframeProfile = iframeIdx[0];
+      for (int cnt = 0; cnt <= iframeTrackIdx; cnt++) {
+        if (iframeBandwidth[cnt] >= mDefaultIframeBitrate) {
+          break;
+        }
+        mDesiredIframeProfile = iframeIdx[cnt];
+      }
+    } else if (is4K) {
+      int desiredProfileNonIframeBW = (int)mBandwidth[mProfileCount / 2];
+      mDesiredIframeProfile = mLowestIframeProfile = 0;
+      for (int cnt = 0; cnt <= iframeTrackIdx; cnt++) {
+        if (iframeBandwidth[cnt] == desiredProfileNonIframeBW) {
+          mDesiredIframeProfile = mLowestIframeProfile = iframeIdx[cnt];
+          break;
+        }
+      }
+      if ((!mDesiredIframeProfile) && (iframeTrackIdx >= 1)) {
+        int desiredTrackIdx = (iframeTrackIdx / 2) + (iframeTrackIdx % 2);
+        mDesiredIframeProfile = mLowestIframeProfile = iframeIdx[desiredTrackIdx];
+      }
+    } else {
+      for (int cnt = 0; cnt <= iframeTrackIdx; cnt++) {
+        if (mLowestIframeProfile == INVALID_PROFILE) {
+          mLowestIframeProfile = mDesiredIframeProfile = iframeIdx[cnt];
+          continue;
+        }
+        mDesiredIframeProfile = iframeIdx[cnt];
+        break;
+      }
+    }
+  }
+
+  /**
+   * @fn getInitialProfileIndex
+   * @see ABRManager::getInitialProfileIndex
+   */
+  int getInitialProfileIndex(bool chooseMediumProfile, const std::string& periodId = std::string()) const {
+    int period = findPeriod(periodId.c_str());
+    if (mProfileCount == 0 || period < 0) {
+      return INVALID_PROFILE;
+    }
+    const uint8_t* sorted = mSorted[period];
+    int count = mSortedCount[period];
+    if (count == 0) {
+      return INVALID_PROFILE;
+    }
+    if (chooseMediumProfile && mProfileCount > 1) {
+      return sorted[count / 2];
+    }
+    int desiredProfileIndex = sorted[0];
+    for (int pos = 0; pos < count && mBandwidth[sorted[pos]] <= mDefaultInitBitrate; pos++) {
+      desiredProfileIndex = sorted[pos];
+    }
+    return desiredProfileIndex;
+  }
+
+  /**
+   * @fn getBestMatchedProfileIndexByBandWidth
+   * @see ABRManager::getBestMatchedProfileIndexByBandWidth
+   */
+  int getBestMatchedProfileIndexByBandWidth(int bandwidth) const {
+    int desiredProfileIndex = 0;
+    for (int i = 0; i < mProfileCount; i++) {
+      if (mIsIframe[i]) {
+        continue;
+      }
+      if (mBandwidth[i] == bandwidth) {
+        desiredProfileIndex = i;
+        break;
+      } else if (mBandwidth[i] < bandwidth) {
+        if ((i + 1) == mProfileCount) {
+          desiredProfileIndex = i;
+          break;
+        }
+        desiredProfileIndex = i + 1;
+      }
+    }
+    return desiredProfileIndex;
+  }
+
+  /**
+   * @fn getRampedDownProfileIndex
+   * @see ABRManager::getRampedDownProfileIndex
+   */
+  int getRampedDownProfileIndex(int currentProfileIndex, const std::string& periodId = std::string()) const {
+    if (mProfileCount == 0) {
+      return currentProfileIndex;
+    }
+    currentProfileIndex = clampProfileIndex(currentProfileIndex);
+    int period = findPeriod(periodId.c_str());
+    int pos = findSorted(period, mBandwidth[currentProfileIndex]);
+    if (pos < 0) {
+      return currentProfileIndex;
+    }
+    return mSorted[period][pos > 0 ? pos - 1 : 0];
+  }
+
+  /**
+   * @fn getRampedUpProfileIndex
+   * @see ABRManager::getRampedUpProfileIndex
+   */
+  int getRampedUpProfileIndex(int currentProfileIndex, const std::string& periodId = std::string()) const {
+    if (mProfileCount == 0 || currentProfileIndex < 0 || currentProfileIndex >= mProfileCount) {
+      return currentProfileIndex;
+    }
+    int period = findPeriod(periodId.c_str());
+    int pos = findSorted(period, mBandwidth[currentProfileIndex]);
+    if (pos < 0) {
+      return currentProfileIndex;
+    }
+    return (pos + 1 < mSortedCount[period]) ? mSorted[period][pos + 1] : currentProfileIndex;
+  }
+
+  /**
+   * @fn isProfileIndexBitrateLowest
+   * @see ABRManager::isProfileIndexBitrateLowest
+   */
+  bool isProfileIndexBitrateLowest(int currentProfileIndex, const std::string& periodId = std::string()) const {
+    if (mProfileCount == 0) {
+      return true;
+    }
+    currentProfileIndex = clampProfileIndex(currentProfileIndex);
+    int period = findPeriod(periodId.c_str());
+    return findSorted(period, mBandwidth[currentProfileIndex]) == 0
+      || (period >= 0 && mSortedCount[period] == 0) || period < 0;
+  }
+
+  /**
+   * @fn getProfileIndexByBitrateRampUpOrDown
+   * @see ABRManager::getProfileIndexByBitrateRampUpOrDown
+   */
+  int getProfileIndexByBitrateRampUpOrDown(int currentProfileIndex, long currentBandwidth, long networkBandwidth,
+    int nwConsistencyCnt = DEFAULT_ABR_NW_CONSISTENCY_COUNT, const std::string& periodId = std::string()) {
+    if (currentProfileIndex >= mProfileCount) {
+      currentProfileIndex = mProfileCount - 1;
+    }
+    int desiredProfileIndex = currentProfileIndex;
+    if (networkBandwidth == -1) {
+      mAbrProfileChangeUpCount = 0;
+      mAbrProfileChangeDownCount = 0;
+      return desiredProfileIndex;
+    }
+    int period = findPeriod(periodId.c_str());
+    if (period < 0 || mSortedCount[period] == 0) {
+      return desiredProfileIndex;
+    }
+    const uint8_t* sorted = mSorted[period];
+    int count = mSortedCount[period];
+    int currPos = findSorted(period, currentBandwidth);
+    int storedPos = -1;
+
+    if (networkBandwidth > currentBandwidth) {
+      for (int pos = currPos; pos >= 0 && pos < count; pos++) {
+        if (networkBandwidth >= mBandwidth[sorted[pos]]) {
+          desiredProfileIndex = sorted[pos];
+          storedPos = pos;
+        } else {
+          break;
+        }
+      }
+      // No need to jump one profile for one network bw increase
+      if (storedPos >= 0 && storedPos - currPos == 1) {
+        if (++mAbrProfileChangeUpCount < nwConsistencyCnt) {
+          desiredProfileIndex = currentProfileIndex;
+        } else {
+          mAbrProfileChangeUpCount = 0;
+        }
+      } else {
+        mAbrProfileChangeUpCount = 0;
+      }
+      mAbrProfileChangeDownCount = 0;
+    } else {
+      for (int pos = count - 1; pos >= 0; pos--) {
+        if (networkBandwidth >= mBandwidth[sorted[pos]]) {
+          desiredProfileIndex = sorted[pos];
+          storedPos = pos;
+          break;
+        }
+      }
+      // No profile supports this bandwidth, set the lowest
+      if (storedPos < 0) {
+        desiredProfileIndex = sorted[0];
+      }
+      // No need to jump one profile for small network change
+      if (storedPos >= 0 && currPos >= 0 && currPos - storedPos == 1) {
+        if (++mAbrProfileChangeDownCount < nwConsistencyCnt) {
+          desiredProfileIndex = currentProfileIndex;
+        } else {
+          mAbrProfileChangeDownCount = 0;
+        }
+      } else {
+        mAbrProfileChangeDownCount = 0;
+      }
+      mAbrProfileChangeUpCount = 0;
+    }
+    return desiredProfileIndex;
+  }
+
+  /**
+   * @fn getBandwidthOfProfile
+   * @see ABRManager::getBandwidthOfProfile
+   */
+  long getBandwidthOfProfile(int profileIndex) const {
+    if (mProfileCount == 0) {
+      return 0;
+    }
+    return mBandwidth[clampProfileIndex(profileIndex)];
+  }
+
+  /**
+   * @fn getMaxBandwidthProfile
+   * @see ABRManager::getMaxBandwidthProfile
+   */
+  int getMaxBandwidthProfile(const std::string& periodId = std::string()) const {
+    int period = findPeriod(periodId.c_str());
+    if (mProfileCount == 0 || period < 0 || mSortedCount[period] == 0) {
+      return 0;
+    }
+    return mSorted[period][mSortedCount[period] - 1];
+  }
+
+  /**
+   * @fn getUserDataOfProfile
+   * @see ABRManager::getUserDataOfProfile
+   */
+  int getUserDataOfProfile(int profileIndex) const {
+    if (profileIndex < 0 || profileIndex >= mProfileCount) {
+      return -1;
+    }
+    return mUserData[profileIndex];
+  }
+
+  /**
+   * @fn getLowestIframeProfile
+   */
+  int getLowestIframeProfile() const { return mLowestIframeProfile; }
+
+  /**
+   * @fn getDesiredIframeProfile
+   */
+  int getDesiredIframeProfile() const { return mDesiredIframeProfile; }
+
+  /**
+   * @fn setDefaultInitBitrate
+   */
+  void setDefaultInitBitrate(long defaultInitBitrate) { mDefaultInitBitrate = defaultInitBitrate; }
+
+  /**
+   * @fn setDefaultIframeBitrate
+   */
+  void setDefaultIframeBitrate(long defaultIframeBitrate) { mDefaultIframeBitrate = defaultIframeBitrate; }
+
+private:
+  /**
+   * @brief Index of a period-Id, -1 if unknown. The hash is compared first,
+   * the period-Id only on a hash match, so colliding period-Ids stay apart.
+   */
+  int findPeriod(const char* periodId) const {
+    uint32_t hash = hashPeriodId(periodId);
+    for (int period = 0; period < mPeriodCount; period++) {
+      if (mPeriodHash[period] == hash && strcmp(mPeriodId[period], periodId) == 0) {
+        return period;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Position of a bandwidth in the sorted list of a period, -1 if absent
+   */
+  int findSorted(int period, long bandwidth) const {
+    if (period < 0) {
+      return -1;
+    }
+    for (int pos = 0; pos < mSortedCount[period]; pos++) {
+      long bw = mBandwidth[mSorted[period][pos]];
+      if (bw == bandwidth) {
+        return pos;
+      }
+      if (bw > bandwidth) {
+        break;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Insert a profile in the sorted list of its period. As in ABRManager,
+   * a profile replaces an earlier one of the same bandwidth.
+   */
+  void insertSorted(int period, int idx) {
+    uint8_t* sorted = mSorted[period];
+    int count = mSortedCount[period];
+    int pos = 0;
+    while (pos < count && mBandwidth[sorted[pos]] < mBandwidth[idx]) {
+      pos++;
+    }
+    if (pos < count && mBandwidth[sorted[pos]] == mBandwidth[idx]) {
+      sorted[pos] = (uint8_t)idx;
+      return;
+    }
+    for (int i = count; i > pos; i--) {
+      sorted[i] = sorted[i - 1];
+    }
+    sorted[pos] = (uint8_t)idx;
+    mSortedCount[period] = (uint8_t)(count + 1);
+  }
+
+  /**
+   * @brief Clamp a profile index to the last profile, as ABRManager does
+   */
+  int clampProfileIndex(int profileIndex) const {
+    if (profileIndex >= mProfileCount) {
+      return mProfileCount - 1;
+    }
+    return (profileIndex < 0) ? 0 : profileIndex;
+  }
+
+  static const int DEFAULT_BITRATE = 1000000;
+  static const int WIDTH_4K = 1920;
+  static const int HEIGHT_4K = 1080;
+  static const int DEFAULT_ABR_NW_CONSISTENCY_COUNT = 2;
+
+  // Hot data, read by the decisions
+  long mBandwidth[MaxProfiles];
+  uint8_t mSorted[MaxPeriods][MaxProfiles];
+  uint8_t mSortedCount[MaxPeriods];
+  uint32_t mPeriodHash[MaxPeriods];
+  bool mIsIframe[MaxProfiles];
+  int mProfileCount;
+  int mPeriodCount;
+
+  // Cold data
+  char mPeriodId[MaxPeriods][MaxPeriodIdLength + 1];
+  int mWidth[MaxProfiles];
+  int mHeight[MaxProfiles];
+  int mUserData[MaxProfiles];
+  int mLowestIframeProfile;
+  int mDesiredIframeProfile;
+  long mDefaultInitBitrate;
+  long mDefaultIframeBitrate;
+  int mAbrProfileChangeUpCount;
+  int mAbrProfileChangeDownCount;
+};
+#endif
@@ -24,6 +24,7 @@
 #include <string>
 #include <cstdio>
 #include "HybridABRManager.h"
+#include "ABRInstrumentation.h"
 #include <cmath>
 #include <chrono>
 #include <cstdio>
@@ -44,6 +45,20 @@
 #define DEFAULT_ABR_CHUNK_CACHE_LENGTH	10					/**< Default ABR chunk cache length */
 #define DEFAULT_ABR_ELAPSED_MILLIS_FOR_ESTIMATE	100			        /**< Duration(ms) to check Chunk Speed */
 #define MAX_LOW_LATENCY_DASH_ABR_SPEEDSTORE_SIZE 10
+#define DEFAULT_ABR_ABANDON_MIN_ELAPSED_MS	500			/**< Download time(ms) before abandonment is considered */
+#define DEFAULT_ABR_ABANDON_BUFFER_SAFETY	0.8			/**< Part of the buffer a re-requested fragment may take */
+#define MAX_ABR_PARALLEL_FETCHES	3					/**< Maximum fragments fetched in parallel */
+#define ABR_PACED_SAMPLE_WEIGHT	0.5					/**< Weight of the paced samples in the bandwidth average */
+#define DEFAULT_ABR_RAMPUP_BACKOFF_FACTOR	2				/**< Growth of the buffer checks between failed rampup probes */
+#define DEFAULT_ABR_RAMPUP_BACKOFF_MAX	64				/**< Maximum buffer checks between two rampup probes */
+#define ABR_TCP_RATE_SMOOTHING	0.3					/**< Gain of the smoothed tcp_info rate */
+#define ABR_TCP_DISCOUNTED_WEIGHT	0.25				/**< Weight of the slow start / app limited rate samples */
+#define ABR_TCP_RTT_CONGESTION_FACTOR	2				/**< RTT over this multiple of the minimum RTT means a queue builds up */
+#define ABR_TCP_FULL_WEIGHT_SAMPLES	8				/**< Rate samples after which the tcp_info rate gets its full weight */
+#define ABR_TCP_MAX_WEIGHT	0.5					/**< Full weight of the tcp_info rate in the fused estimate */
+#define DEFAULT_ABR_FAST_START_MAX_STEP	4					/**< Profiles climbed at most in one fast start decision */
+#define DEFAULT_ABR_FAST_START_FRAGMENTS	3				/**< Fragments of the fast start phase */
+#define ABR_FAST_START_MIN_BANDWIDTH_SHARE	0.5				/**< Part of the bandwidth a profile may use on an empty buffer */
 //Low Latency DASH SERVICE PROFILE URL
 #define LL_DASH_SERVICE_PROFILE "http://www.dashif.org/guidelines/low-latency-live-v5"
 
@@ -54,56 +69,71 @@
 	} while (0)
 
 
-#define AAMPABRLOG_TRACE(FORMAT, ...) AAMPABRLOG(eAAMPAbrConfig.tracelogging,"TRACE",FORMAT, ##__VA_ARGS__)
-#define AAMPABRLOG_INFO(FORMAT, ...)  AAMPABRLOG(eAAMPAbrConfig.infologging,"INFO",FORMAT, ##__VA_ARGS__)
-#define AAMPABRLOG_WARN(FORMAT, ...)  AAMPABRLOG(eAAMPAbrConfig.warnlogging,"WARN",FORMAT, ##__VA_ARGS__)
-#define AAMPABRLOG_ERR(FORMAT, ...)   AAMPABRLOG(eAAMPAbrConfig.debuglogging,"ERROR",FORMAT, ##__VA_ARGS__)
-HybridABRManager::AampAbrConfig eAAMPAbrConfig = {0,0,0,0,0,0,0,0,0,0,0};
+#define AAMPABRLOG_TRACE(FORMAT, ...) AAMPABRLOG(abrConfig->tracelogging,"TRACE",FORMAT, ##__VA_ARGS__)
+#define AAMPABRLOG_INFO(FORMAT, ...)  AAMPABRLOG(abrConfig->infologging,"INFO",FORMAT, ##__VA_ARGS__)
+#define AAMPABRLOG_WARN(FORMAT, ...)  AAMPABRLOG(abrConfig->warnlogging,"WARN",FORMAT, ##__VA_ARGS__)
+#define AAMPABRLOG_ERR(FORMAT, ...)   AAMPABRLOG(abrConfig->debuglogging,"ERROR",FORMAT, ##__VA_ARGS__)
 
 /**
- * @struct SpeedCache
- * @brief Stroes the information for cache speed
+ * @brief Constructor of HybridABRManager, with an empty configuration
  */
-
-struct SpeedCache
+HybridABRManager::HybridABRManager() :
+	ABRManager(),
+	mABRHighBufferCounter(0),
+	mABRLowBufferCounter(0),
+	mQoEScore(),
+	mAbrConfig(AampAbrConfig()),
+	mRampupBackoffConfig(),
+	mRampupBackoffCount(0),
+	mRampupProbeBandwidth(0),
+	mPacedSamples(),
+	mPacedScratch(),
+	mThroughputAggregator(),
+	mTcpInfo(),
+	mFastStartConfig(),
+	mFastStartReason(eAAMP_BITRATE_CHANGE_MAX),
+	mFastStartFragments(0),
+	mFastStartLastBuffer(0)
 {
-	long last_sample_time_val;
-	long prev_dlnow;
-	long prevSampleTotalDownloaded;
-	long totalDownloaded;
-	long speed_now;
-	long start_val;
-	bool bStart;
-
-	double totalWeight;
-	double weightedBitsPerSecond;
-	std::vector< std::pair<double,long> > mChunkSpeedData;
-
-	SpeedCache() : last_sample_time_val(0), prev_dlnow(0), prevSampleTotalDownloaded(0), totalDownloaded(0), speed_now(0), start_val(0), bStart(false) , totalWeight(0), weightedBitsPerSecond(0), mChunkSpeedData()
-	{
-	}
-};
+	mFastStartConfig.maxStep = DEFAULT_ABR_FAST_START_MAX_STEP;
+	mFastStartConfig.maxFragments = DEFAULT_ABR_FAST_START_FRAGMENTS;
+	mRampupBackoffConfig.baseCount = 0;
+	mRampupBackoffConfig.factor = DEFAULT_ABR_RAMPUP_BACKOFF_FACTOR;
+	mRampupBackoffConfig.maxCount = DEFAULT_ABR_RAMPUP_BACKOFF_MAX;
+}
 
 /** @brief Read Config values
  *  @return none
  */
 void HybridABRManager::ReadPlayerConfig(AampAbrConfig *mAampAbrConfig)
 {
-	eAAMPAbrConfig.abrCacheLife     =  mAampAbrConfig->abrCacheLife;
-	eAAMPAbrConfig.abrCacheLength   =  mAampAbrConfig->abrCacheLength;
-	eAAMPAbrConfig.abrSkipDuration  =  mAampAbrConfig->abrSkipDuration;
-	eAAMPAbrConfig.abrNwConsistency =  mAampAbrConfig->abrNwConsistency;
-	eAAMPAbrConfig.abrThresholdSize =  mAampAbrConfig->abrThresholdSize;
-	eAAMPAbrConfig.abrMaxBuffer     =  mAampAbrConfig->abrMaxBuffer;
-	eAAMPAbrConfig.abrMinBuffer     =  mAampAbrConfig->abrMinBuffer;
+	ABR_PROFILE_API(eAPI_READ_PLAYER_CONFIG);
+	AampAbrConfig config = AampAbrConfig();
+	config.abrCacheLife     =  mAampAbrConfig->abrCacheLife;
+	config.abrCacheLength   =  mAampAbrConfig->abrCacheLength;
+	config.abrSkipDuration  =  mAampAbrConfig->abrSkipDuration;
+	config.abrNwConsistency =  mAampAbrConfig->abrNwConsistency;
+	config.abrThresholdSize =  mAampAbrConfig->abrThresholdSize;
+	config.abrMaxBuffer     =  mAampAbrConfig->abrMaxBuffer;
+	config.abrMinBuffer     =  mAampAbrConfig->abrMinBuffer;
+	config.abrCacheOutlier  =  mAampAbrConfig->abrCacheOutlier;
 
 	//Logging Level 
 
-	eAAMPAbrConfig.infologging     =  mAampAbrConfig->infologging;
-	eAAMPAbrConfig.debuglogging    = mAampAbrConfig->debuglogging;
-	eAAMPAbrConfig.tracelogging    = mAampAbrConfig->tracelogging;
-	eAAMPAbrConfig.warnlogging     = mAampAbrConfig->warnlogging;
-	logprintf("[%s][%d]PlayerConfig : ABRCacheLife %d ,ABRCacheLength %d ,ABRSkipDuration %d , ABRNwConsistency %d ,ABRThresholdSize %d ,ABRMaxBuffer %d ,ABRMinBuffer %d",__FUNCTION__,__LINE__,eAAMPAbrConfig.abrCacheLife,eAAMPAbrConfig.abrCacheLength,eAAMPAbrConfig.abrSkipDuration,eAAMPAbrConfig.abrNwConsistency,eAAMPAbrConfig.abrThresholdSize,eAAMPAbrConfig.abrMaxBuffer,eAAMPAbrConfig.abrMinBuffer);
+	config.infologging     =  mAampAbrConfig->infologging;
+	config.debuglogging    = mAampAbrConfig->debuglogging;
+	config.tracelogging    = mAampAbrConfig->tracelogging;
+	config.warnlogging     = mAampAbrConfig->warnlogging;
+
+	// Readers keep the snapshot they started with, the next call sees this one
+	unsigned version = mAbrConfig.publish(config);
+	mFlightRecorder.setConfigVersion(version);
+	mMetrics.setConfigVersion(version);
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_CONFIG, 0, config.abrCacheOutlier,
+		config.abrCacheLife, config.abrCacheLength, config.abrSkipDuration,
+		config.abrNwConsistency, config.abrThresholdSize,
+		((int64_t)config.abrMaxBuffer << 32) | (uint32_t)config.abrMinBuffer);
+	logprintf("[%s][%d]PlayerConfig v%u : ABRCacheLife %d ,ABRCacheLength %d ,ABRSkipDuration %d , ABRNwConsistency %d ,ABRThresholdSize %d ,ABRMaxBuffer %d ,ABRMinBuffer %d",__FUNCTION__,__LINE__,version,config.abrCacheLife,config.abrCacheLength,config.abrSkipDuration,config.abrNwConsistency,config.abrThresholdSize,config.abrMaxBuffer,config.abrMinBuffer);
 
 }
 
@@ -115,14 +145,18 @@ void HybridABRManager::ReadPlayerConfig(AampAbrConfig *mAampAbrConfig)
 
 long HybridABRManager::CheckAbrThresholdSize(int bufferlen, int downloadTimeMs ,long currentProfilebps ,int fragmentDurationMs , CurlAbortReason abortReason)
 {
+	ABR_PROFILE_API(eAPI_CHECK_ABR_THRESHOLD_SIZE);
 	char buf[6] = {0,};
 	long downloadbps = ((long)(bufferlen / downloadTimeMs)*8000);
+	mMetrics.recordThroughputSample(downloadbps);
 	// extra coding to avoid picking lower profile
 	// Avoid this reset for Low bandwidth timeout cases
 	if(downloadbps < currentProfilebps && fragmentDurationMs && downloadTimeMs < fragmentDurationMs/2 && (abortReason != eCURL_ABORT_REASON_LOW_BANDWIDTH_TIMEDOUT)) 
 	{
 		downloadbps = currentProfilebps;
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_THRESHOLD_SIZE, 0, 0,
+		bufferlen, downloadTimeMs, currentProfilebps, fragmentDurationMs, abortReason, downloadbps);
 	return downloadbps;
 
 }
@@ -133,18 +167,191 @@ long HybridABRManager::CheckAbrThresholdSize(int bufferlen, int downloadTimeMs ,
  */
 void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLength(std::vector < std::pair<long long,long> > &mAbrBitrateData,long downloadbps,bool LowLatencyMode)
 {
-	mAbrBitrateData.push_back(std::make_pair(ABRGetCurrentTimeMS() ,downloadbps));
+	ABR_PROFILE_API(eAPI_UPDATE_CACHE_LENGTH);
+	ConfigReader abrConfig(mAbrConfig);
+	long long presentTime = ABRGetCurrentTimeMS();
+	int cacheLength = LowLatencyMode ? DEFAULT_ABR_CHUNK_CACHE_LENGTH : abrConfig->abrCacheLength;
+	if(cacheLength > 0)
+	{
+		// Sized once for the full cache plus the incoming sample, no reallocation after
+		mAbrBitrateData.reserve(cacheLength + 1);
+	}
+	mAbrBitrateData.push_back(std::make_pair(presentTime ,downloadbps));
 	//AAMPLOG_WARN("CacheSz[%d]ConfigSz[%d] Storing Size [%d] bps[%ld]",mAbrBitrateData.size(),abrCacheLength, buffer->len, ((long)(buffer->len / downloadTimeMS)*8000));
-	if(LowLatencyMode)
+	if(mAbrBitrateData.size() > (size_t)cacheLength)
 	{
-		if(mAbrBitrateData.size() > DEFAULT_ABR_CHUNK_CACHE_LENGTH)
-			mAbrBitrateData.erase(mAbrBitrateData.begin());
+		mAbrBitrateData.erase(mAbrBitrateData.begin());
+		// Paced samples leave the cache with their sample
+		long long oldestTime = mAbrBitrateData.empty() ? presentTime : mAbrBitrateData.front().first;
+		size_t evicted = 0;
+		while(evicted < mPacedSamples.size() && mPacedSamples[evicted].first < oldestTime)
+			evicted++;
+		mPacedSamples.erase(mPacedSamples.begin(), mPacedSamples.begin() + evicted);
+	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_CACHE_LENGTH, 0, 0,
+		presentTime, downloadbps, LowLatencyMode, mAbrBitrateData.size());
+}
+
+/**
+ * @brief Function to Update Persisted Recent Download Statistics Based on Cache Length, with a possibly paced sample
+ * @return none
+ */
+void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLength(std::vector < std::pair<long long,long> > &mAbrBitrateData,long downloadbps,bool LowLatencyMode,bool pacedSample)
+{
+	UpdateABRBitrateDataBasedOnCacheLength(mAbrBitrateData, downloadbps, LowLatencyMode);
+	// A download started from idle measures the connection ramp up as well as the link:
+	// the sample is stored as measured, and marked to weigh less in the average
+	if(pacedSample && !mAbrBitrateData.empty())
+	{
+		if(mPacedSamples.capacity() < mAbrBitrateData.capacity())
+		{
+			mPacedSamples.reserve(mAbrBitrateData.capacity());
+		}
+		mPacedSamples.push_back(mAbrBitrateData.back());
+	}
+}
+
+/**
+ * @brief A fragment download starts
+ */
+int HybridABRManager::BeginTransfer()
+{
+	return mThroughputAggregator.begin(ABRGetCurrentTimeMS());
+}
+
+/**
+ * @brief Bytes received so far by a download
+ */
+void HybridABRManager::ProgressTransfer(int transferId,long bytesSoFar)
+{
+	mThroughputAggregator.progress(transferId, bytesSoFar);
+}
+
+/**
+ * @brief A fragment download ends, feeds the link throughput of an ended busy period
+ */
+long HybridABRManager::EndTransfer(int transferId,long bytes,std::vector < std::pair<long long,long> > &mAbrBitrateData)
+{
+	ABR_PROFILE_API(eAPI_END_TRANSFER);
+	ConfigReader abrConfig(mAbrConfig);
+	long long periodBytes = 0;
+	long throughput = mThroughputAggregator.end(transferId, ABRGetCurrentTimeMS(), bytes, periodBytes);
+	// Small periods are dominated by the request latency, as small fragments
+	if(throughput > 0 && periodBytes > abrConfig->abrThresholdSize)
+	{
+		AAMPABRLOG_TRACE("[%s][%d] Link throughput %ld over %lld bytes",__FUNCTION__,__LINE__,throughput,periodBytes);
+		mMetrics.recordThroughputSample(throughput);
+		UpdateABRBitrateDataBasedOnCacheLength(mAbrBitrateData, throughput, false);
 	}
 	else
 	{
-		if(mAbrBitrateData.size() > eAAMPAbrConfig.abrCacheLength)
-			mAbrBitrateData.erase(mAbrBitrateData.begin());
+		throughput = -1;
+	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_LINK_THROUGHPUT, 0, throughput,
+		transferId, bytes, periodBytes, mThroughputAggregator.getActiveCount());
+	return throughput;
+}
+
+/**
+ * @brief Account a tcp_info snapshot of the download socket
+ */
+bool HybridABRManager::ReportTcpInfo(const TcpInfoSample &sample)
+{
+	ABR_PROFILE_API(eAPI_REPORT_TCP_INFO);
+	ConfigReader abrConfig(mAbrConfig);
+	long long now = ABRGetCurrentTimeMS();
+	long rate = sample.deliveryRate;
+	if(rate <= 0 && mTcpInfo.lastTimeMs > 0 && now > mTcpInfo.lastTimeMs && sample.bytesReceived > mTcpInfo.lastBytes)
+	{
+		rate = (long)((sample.bytesReceived - mTcpInfo.lastBytes) * 8000 / (now - mTcpInfo.lastTimeMs));
+	}
+	// In slow start the rate follows the cwnd growth, not the link
+	bool slowStart = sample.cwnd > 0 && sample.ssthresh > 0 && sample.cwnd < sample.ssthresh;
+	if(rate > 0)
+	{
+		double gain = ABR_TCP_RATE_SMOOTHING * ((slowStart || sample.appLimited) ? ABR_TCP_DISCOUNTED_WEIGHT : 1.0);
+		mTcpInfo.rateBps = (mTcpInfo.rateSamples == 0) ? rate : mTcpInfo.rateBps + gain * (rate - mTcpInfo.rateBps);
+		if(!slowStart && !sample.appLimited)
+			mTcpInfo.rateSamples++;
 	}
+	if(sample.rttUs > 0 && (mTcpInfo.minRttUs == 0 || sample.rttUs < mTcpInfo.minRttUs))
+	{
+		mTcpInfo.minRttUs = sample.rttUs;
+	}
+	bool retransmitted = mTcpInfo.lastTimeMs > 0 && sample.totalRetrans > mTcpInfo.lastRetrans;
+	mTcpInfo.congested = retransmitted || (mTcpInfo.minRttUs > 0 && sample.rttUs >= mTcpInfo.minRttUs * ABR_TCP_RTT_CONGESTION_FACTOR);
+	if(mTcpInfo.congested)
+	{
+		AAMPABRLOG_TRACE("[%s][%d] Congestion rtt %ld us min %ld us retransmitted %d",__FUNCTION__,__LINE__,sample.rttUs,mTcpInfo.minRttUs,retransmitted);
+	}
+	mTcpInfo.lastTimeMs = now;
+	mTcpInfo.lastBytes = sample.bytesReceived;
+	mTcpInfo.lastRetrans = sample.totalRetrans;
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_TCP_INFO, slowStart, mTcpInfo.congested,
+		rate, sample.rttUs, mTcpInfo.minRttUs, sample.cwnd, sample.totalRetrans, (int64_t)mTcpInfo.rateBps);
+	return mTcpInfo.congested;
+}
+
+/**
+ * @brief Fuse the fragment based estimate with the tcp_info rate
+ */
+long HybridABRManager::FuseTcpInfoEstimate(long fragmentEstimate)
+{
+	ABR_PROFILE_API(eAPI_FUSE_TCP_INFO_ESTIMATE);
+	ConfigReader abrConfig(mAbrConfig);
+	bool recent = mTcpInfo.lastTimeMs > 0 && ABRGetCurrentTimeMS() - mTcpInfo.lastTimeMs <= abrConfig->abrCacheLife;
+	if(!recent || mTcpInfo.rateBps <= 0)
+	{
+		return fragmentEstimate;
+	}
+	long tcpRate = (long)mTcpInfo.rateBps;
+	if(fragmentEstimate <= 0)
+	{
+		return tcpRate;
+	}
+	if(mTcpInfo.congested)
+	{
+		return std::min(fragmentEstimate, tcpRate);
+	}
+	double weight = ABR_TCP_MAX_WEIGHT * std::min(mTcpInfo.rateSamples, ABR_TCP_FULL_WEIGHT_SAMPLES) / ABR_TCP_FULL_WEIGHT_SAMPLES;
+	return (long)(weight * tcpRate + (1 - weight) * fragmentEstimate);
+}
+
+/**
+ * @brief Advise when to fetch the next fragment and how many in parallel
+ * @return none
+ */
+void HybridABRManager::GetFetchAdvice(double bufferValue,double fragmentDuration,long nwBandwidth,long profileBandwidth,FetchAdvice &advice)
+{
+	ABR_PROFILE_API(eAPI_GET_FETCH_ADVICE);
+	ConfigReader abrConfig(mAbrConfig);
+	long long now = ABRGetCurrentTimeMS();
+	advice.fetchTimeMs = now;
+	advice.parallelFetches = 1;
+	advice.paced = false;
+	if(bufferValue < abrConfig->abrMinBuffer)
+	{
+		// Filling up: overlap the requests the link can carry together
+		if(nwBandwidth > 0 && profileBandwidth > 0)
+		{
+			advice.parallelFetches = (int)std::min(std::max(nwBandwidth / profileBandwidth, 1L), (long)MAX_ABR_PARALLEL_FETCHES);
+		}
+	}
+	else if(bufferValue >= abrConfig->abrMaxBuffer)
+	{
+		// Full: wait for one fragment to play out, so the link is used at the playback
+		// rate instead of in bursts, and less is fetched ahead of a channel change
+		double waitSeconds = bufferValue - (abrConfig->abrMaxBuffer - fragmentDuration);
+		if(waitSeconds > 0)
+		{
+			advice.fetchTimeMs = now + (long long)(waitSeconds * 1000);
+			advice.paced = true;
+		}
+	}
+	AAMPABRLOG_TRACE("[%s][%d] bufferValue %lf fragmentDuration %lf nwBandwidth %ld delay %lld parallel %d",__FUNCTION__,__LINE__,bufferValue,fragmentDuration,nwBandwidth,advice.fetchTimeMs - now,advice.parallelFetches);
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_FETCH_ADVICE, 0, advice.paced,
+		(int64_t)(bufferValue * 1000), (int64_t)(fragmentDuration * 1000), nwBandwidth, profileBandwidth,
+		advice.fetchTimeMs - now, advice.parallelFetches);
 }
 
 /**
@@ -153,12 +360,16 @@ void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLength(std::vector < std:
  */
 void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLife(std::vector < std::pair<long long,long> > &mAbrBitrateData , std::vector< long> &tmpData)
 {
+	ABR_PROFILE_API(eAPI_UPDATE_CACHE_LIFE);
+	ConfigReader abrConfig(mAbrConfig);
 	std::vector< std::pair<long long,long> >::iterator bitrateIter;
 	long long presentTime = ABRGetCurrentTimeMS();
+	// The caller clears tmpData and reuses it, it stops growing with the cache
+	tmpData.reserve(tmpData.size() + mAbrBitrateData.size());
 	for (bitrateIter = mAbrBitrateData.begin(); bitrateIter != mAbrBitrateData.end();)
 	{
 		//AAMPLOG_WARN("Sz[%d] TimeCheck Pre[%lld] Sto[%lld] diff[%lld] bw[%ld] ",mAbrBitrateData.size(),presentTime,(*bitrateIter).first,(presentTime - (*bitrateIter).first),(long)(*bitrateIter).second);
-		if ((bitrateIter->first <= 0) || (presentTime - bitrateIter->first > eAAMPAbrConfig.abrCacheLife))
+		if ((bitrateIter->first <= 0) || (presentTime - bitrateIter->first > abrConfig->abrCacheLife))
 		{
 			//AAMPLOG_WARN("Threadshold time reached , removing bitrate data ");
 			bitrateIter = mAbrBitrateData.erase(bitrateIter);
@@ -169,6 +380,12 @@ void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLife(std::vector < std::p
 			bitrateIter++;
 		}
 	}
+	size_t expired = 0;
+	while(expired < mPacedSamples.size() && presentTime - mPacedSamples[expired].first > abrConfig->abrCacheLife)
+		expired++;
+	mPacedSamples.erase(mPacedSamples.begin(), mPacedSamples.begin() + expired);
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_CACHE_LIFE, 0, 0,
+		presentTime, mAbrBitrateData.size(), tmpData.size());
 }
 
 
@@ -178,12 +395,15 @@ void HybridABRManager::UpdateABRBitrateDataBasedOnCacheLife(std::vector < std::p
  */
 long HybridABRManager::UpdateABRBitrateDataBasedOnCacheOutlier(std::vector< long> &tmpData)
 {
+	ABR_PROFILE_API(eAPI_UPDATE_CACHE_OUTLIER);
+	ConfigReader abrConfig(mAbrConfig);
 	long avg = 0;
 	long ret = -1;
 	std::vector< long>::iterator tmpDataIter;
 	long medianbps=0;
 	long long presentTime = ABRGetCurrentTimeMS();
 	int abrOutlierDiffBytes;
+	int outliers = 0;
 
 	std::sort(tmpData.begin(),tmpData.end());
 	if (tmpData.size() %2)
@@ -197,35 +417,64 @@ long HybridABRManager::UpdateABRBitrateDataBasedOnCacheOutlier(std::vector< long
 		medianbps = (m1+m2)/2;
 	}
 
+	// Paced samples, sorted as tmpData, are matched by value while walking it
+	mPacedScratch.clear();
+	mPacedScratch.reserve(mPacedSamples.capacity());
+	for (size_t i = 0; i < mPacedSamples.size(); i++)
+	{
+		mPacedScratch.push_back(mPacedSamples[i].second);
+	}
+	std::sort(mPacedScratch.begin(), mPacedScratch.end());
+	size_t pacedIndex = 0;
+	int pacedKept = 0;
+	double weightedSum = 0;
+	double totalWeight = 0;
+
+	size_t samples = tmpData.size();
 	long diffOutlier = 0;
 	avg = 0;
-	abrOutlierDiffBytes = eAAMPAbrConfig.abrCacheOutlier ;
+	abrOutlierDiffBytes = abrConfig->abrCacheOutlier ;
 	for (tmpDataIter = tmpData.begin();tmpDataIter != tmpData.end();)
 	{
+		while (pacedIndex < mPacedScratch.size() && mPacedScratch[pacedIndex] < (*tmpDataIter))
+			pacedIndex++;
+		bool paced = (pacedIndex < mPacedScratch.size() && mPacedScratch[pacedIndex] == (*tmpDataIter));
+		if (paced)
+			pacedIndex++;
 		diffOutlier = (*tmpDataIter) > medianbps ? (*tmpDataIter) - medianbps : medianbps - (*tmpDataIter);
 		if (diffOutlier > abrOutlierDiffBytes)
 		{
 			//AAMPLOG_WARN("Outlier found[%ld]>[%ld] erasing ....",diffOutlier,abrOutlierDiffBytes);
 			tmpDataIter = tmpData.erase(tmpDataIter);
+			outliers++;
 		}
 		else
 		{
+			double weight = paced ? ABR_PACED_SAMPLE_WEIGHT : 1.0;
 			avg += (*tmpDataIter);
+			weightedSum += weight * (*tmpDataIter);
+			totalWeight += weight;
+			pacedKept += paced;
 			tmpDataIter++;
 		}
 	}
+	mMetrics.recordOutliersDropped(outliers);
 	if (tmpData.size())
 	{
 		//AAMPLOG_WARN("NwBW with newlogic size[%d] avg[%ld] ",tmpData.size(), avg/tmpData.size());
-		ret = (avg/tmpData.size());
+		ret = pacedKept ? (long)(weightedSum / totalWeight) : (avg/tmpData.size());
 		//Store the PersistBandwidth and UpdatedTime on ABRManager
-		//Bitrate Update only for foreground player
+		//Bitrate Update only for foreground player, which is the one with a bandwidth store attached
+		recordBandwidthHistory(ret);
+		mMetrics.recordEstimate(ret);
 	}
 	else
 	{
 		//AAMPLOG_WARN("No prior data available for abr , return -1 ");
 		ret = -1;
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_CACHE_OUTLIER, 0, 0,
+		samples, outliers, ret);
 	return ret;
 
 }
@@ -236,10 +485,12 @@ long HybridABRManager::UpdateABRBitrateDataBasedOnCacheOutlier(std::vector< long
 
 bool HybridABRManager::CheckProfileChange(double totalFetchedDuration ,int currProfileIndex , long availBW)
 {
+	ABR_PROFILE_API(eAPI_CHECK_PROFILE_CHANGE);
+	ConfigReader abrConfig(mAbrConfig);
 	bool checkProfileChange = true;
 	long currBW = getBandwidthOfProfile(currProfileIndex);
 	//Avoid doing ABR during initial buffering which will affect tune times adversely
-	if ( totalFetchedDuration > 0 && totalFetchedDuration < eAAMPAbrConfig.abrSkipDuration)
+	if ( totalFetchedDuration > 0 && totalFetchedDuration < abrConfig->abrSkipDuration)
 	{
 		AAMPABRLOG_TRACE("[%s][%d] TotalFetchedDuration %lf ",__FUNCTION__,__LINE__,totalFetchedDuration);
 		//For initial fragment downloads, check available bw is less than default bw
@@ -254,6 +505,8 @@ bool HybridABRManager::CheckProfileChange(double totalFetchedDuration ,int currP
 			checkProfileChange = false;
 		}
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_PROFILE_CHANGE_CHECK, 0, checkProfileChange,
+		(int64_t)(totalFetchedDuration * 1000), currProfileIndex, availBW);
 	return checkProfileChange;
 
 }
@@ -288,8 +541,11 @@ bool HybridABRManager::IsLowestProfile(int currentProfileIndex,bool IstrickplayM
 
 void HybridABRManager::GetDesiredProfileOnBuffer(int currProfileIndex,int &newProfileIndex,double bufferValue,double minBufferNeeded,const std::string& periodId)
 {
+	ABR_PROFILE_API(eAPI_GET_DESIRED_PROFILE_ON_BUFFER);
+	ConfigReader abrConfig(mAbrConfig);
 	long currentBandwidth = getBandwidthOfProfile(currProfileIndex);
 	long newBandwidth     = getBandwidthOfProfile(newProfileIndex);
+	int requestedProfileIndex = newProfileIndex;
 	AAMPABRLOG_INFO("[%s][%d] CurrProfileIndex %d ,newProfileIndex %d,CurrentBandwidth %ld,newBandwidth %ld,BufferValue %lf ,minBufferNeeded %lf",__FUNCTION__, __LINE__, currProfileIndex,newProfileIndex,currentBandwidth,newBandwidth,bufferValue,minBufferNeeded);
 	if(bufferValue > 0 )
 	{
@@ -297,7 +553,7 @@ void HybridABRManager::GetDesiredProfileOnBuffer(int currProfileIndex,int &newPr
 		{
 			// Rampup attempt . check if buffer availability is good before profile change
 			// else retain current profile
-			if(bufferValue < eAAMPAbrConfig.abrMaxBuffer)
+			if(bufferValue < abrConfig->abrMaxBuffer)
 				newProfileIndex = currProfileIndex;
 		}
 		else
@@ -310,6 +566,9 @@ void HybridABRManager::GetDesiredProfileOnBuffer(int currProfileIndex,int &newPr
 				newProfileIndex = currProfileIndex;
 		}
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_DESIRED_ON_BUFFER, 0, newProfileIndex,
+		currProfileIndex, requestedProfileIndex, (int64_t)(bufferValue * 1000), (int64_t)(minBufferNeeded * 1000),
+		ABRFlightRecorder::hashPeriodId(periodId));
 }
 
 /**
@@ -318,19 +577,43 @@ void HybridABRManager::GetDesiredProfileOnBuffer(int currProfileIndex,int &newPr
 
 void HybridABRManager::CheckRampupFromSteadyState(int currProfileIndex,int &newProfileIndex,long nwBandwidth,double bufferValue,long newBandwidth,BitrateChangeReason &mhBitrateReason,int &mMaxBufferCountCheck,const std::string& periodId)
 {
+	ABR_PROFILE_API(eAPI_CHECK_RAMPUP_FROM_STEADY_STATE);
+	ConfigReader abrConfig(mAbrConfig);
 	AAMPABRLOG_INFO("[%s][%d]  currProfileIndex %d, newProfileIndex %d ,nwBandwidth %ld ,bufferValue %lf ,newBandwidth %ld ",__FUNCTION__,__LINE__,currProfileIndex,newProfileIndex,nwBandwidth,bufferValue,newBandwidth);
+	int requestedProfileIndex = newProfileIndex;
+	// Outcome of the previous probe: it succeeded if its profile was kept
+	int baseCount = mRampupBackoffConfig.baseCount > 0 ? mRampupBackoffConfig.baseCount : abrConfig->abrCacheLength;
+	int maxCount = std::max(mRampupBackoffConfig.maxCount, baseCount);
+	if(mRampupProbeBandwidth > 0)
+	{
+		if(getBandwidthOfProfile(currProfileIndex) >= mRampupProbeBandwidth)
+		{
+			mRampupBackoffCount = 0;
+		}
+		else
+		{
+			int count = mRampupBackoffCount > 0 ? mRampupBackoffCount : baseCount;
+			int factor = std::max(mRampupBackoffConfig.factor, 1);
+			mRampupBackoffCount = (count > maxCount / factor) ? maxCount : count * factor;
+		}
+		mRampupProbeBandwidth = 0;
+	}
 	int nProfileIdx = getRampedUpProfileIndex(currProfileIndex,periodId);
+	// Buffer full rampup stays within the data saver cap
+	if(getBandwidthOfProfile(nProfileIdx) > getDataSaverBandwidthCap())
+		nProfileIdx = currProfileIndex;
 	if(newBandwidth - nwBandwidth < 2000000)
 		newProfileIndex = nProfileIdx;
 	if(newProfileIndex  != currProfileIndex)
 	{
-		static int loop = 1;
 		AAMPABRLOG_WARN("Attempted rampup from steady state ->currProf:%d newProf:%d bufferValue:%lf",
 				currProfileIndex,newProfileIndex,bufferValue);
-		loop = (++loop >4)?1:loop;
-		mMaxBufferCountCheck =  pow(eAAMPAbrConfig.abrCacheLength,loop);
+		mRampupProbeBandwidth = getBandwidthOfProfile(newProfileIndex);
+		mMaxBufferCountCheck = mRampupBackoffCount > 0 ? mRampupBackoffCount : baseCount;
 		mhBitrateReason = eAAMP_BITRATE_CHANGE_BY_BUFFER_FULL;
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_RAMPUP_STEADY_STATE, mhBitrateReason, newProfileIndex,
+		currProfileIndex, requestedProfileIndex, nwBandwidth, (int64_t)(bufferValue * 1000), newBandwidth, mMaxBufferCountCheck);
 }
 
 /**
@@ -339,8 +622,11 @@ void HybridABRManager::CheckRampupFromSteadyState(int currProfileIndex,int &newP
 
 void HybridABRManager::CheckRampdownFromSteadyState(int currProfileIndex, int &newProfileIndex,BitrateChangeReason &mBitrateReason,int mABRLowBufferCounter,const std::string& periodId)
 {
+	ABR_PROFILE_API(eAPI_CHECK_RAMPDOWN_FROM_STEADY_STATE);
+	ConfigReader abrConfig(mAbrConfig);
 	AAMPABRLOG_INFO("[%s][%d] currProfileIndex %d ,newProfileIndex %d, mABRLowBufferCounter %d",__FUNCTION__,__LINE__,currProfileIndex,newProfileIndex,mABRLowBufferCounter);
-	if(mABRLowBufferCounter > eAAMPAbrConfig.abrCacheLength)
+	int requestedProfileIndex = newProfileIndex;
+	if(mABRLowBufferCounter > abrConfig->abrCacheLength)
 	{
 		newProfileIndex = getRampedDownProfileIndex(currProfileIndex,periodId);
 		if(newProfileIndex  != currProfileIndex)
@@ -349,6 +635,154 @@ void HybridABRManager::CheckRampdownFromSteadyState(int currProfileIndex, int &n
 			AAMPABRLOG_WARN("Attempted rampdown from steady state ->currProf:%d newProf:%d",currProfileIndex,newProfileIndex);
 		}
 	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_RAMPDOWN_STEADY_STATE, mBitrateReason, newProfileIndex,
+		currProfileIndex, requestedProfileIndex, mABRLowBufferCounter, ABRFlightRecorder::hashPeriodId(periodId));
+}
+
+/**
+ * @brief Start the fast start phase
+ */
+void HybridABRManager::StartFastStart(BitrateChangeReason reason)
+{
+	if(reason == eAAMP_BITRATE_CHANGE_BY_TUNE || reason == eAAMP_BITRATE_CHANGE_BY_SEEK)
+	{
+		mFastStartReason = reason;
+		mFastStartFragments = 0;
+		mFastStartLastBuffer = 0;
+	}
+}
+
+/**
+ * @brief Set the backoff of the buffer full rampup probes
+ */
+void HybridABRManager::SetRampupBackoffConfig(const RampupBackoffConfig &config)
+{
+	mRampupBackoffConfig = config;
+	mRampupBackoffCount = 0;
+}
+
+/**
+ * @brief Set the limits of the fast start phase
+ */
+void HybridABRManager::SetFastStartConfig(const FastStartConfig &config)
+{
+	mFastStartConfig = config;
+}
+
+/**
+ * @brief Check whether the fast start phase is running
+ */
+bool HybridABRManager::IsFastStartActive() const
+{
+	return mFastStartReason != eAAMP_BITRATE_CHANGE_MAX;
+}
+
+/**
+ *  @brief Get Desired Profile during the fast start phase
+ */
+bool HybridABRManager::GetFastStartProfileIndex(int currProfileIndex,int &newProfileIndex,long nwBandwidth,double bufferValue,BitrateChangeReason &mhBitrateReason,const std::string& periodId)
+{
+	ABR_PROFILE_API(eAPI_GET_FAST_START_PROFILE_INDEX);
+	ConfigReader abrConfig(mAbrConfig);
+	if(!IsFastStartActive())
+	{
+		return false;
+	}
+	BitrateChangeReason reason = mFastStartReason;
+	int desiredProfileIndex = currProfileIndex;
+	long allowedBandwidth = 0;
+	bool exitPhase = (mFastStartFragments > 0 && bufferValue < mFastStartLastBuffer) || bufferValue >= abrConfig->abrMaxBuffer;
+	if(!exitPhase && nwBandwidth > 0)
+	{
+		// The emptier the buffer, the more of the bandwidth is left to grow it
+		double fill = abrConfig->abrMaxBuffer > 0 ? std::min(std::max(bufferValue / abrConfig->abrMaxBuffer, 0.0), 1.0) : 1.0;
+		double share = ABR_FAST_START_MIN_BANDWIDTH_SHARE + (1 - ABR_FAST_START_MIN_BANDWIDTH_SHARE) * fill;
+		allowedBandwidth = std::min((long)(nwBandwidth * share), getDataSaverBandwidthCap());
+		for(int step = 0; step < mFastStartConfig.maxStep; step++)
+		{
+			int upper = getRampedUpProfileIndex(desiredProfileIndex,periodId);
+			if(upper == desiredProfileIndex || getBandwidthOfProfile(upper) > allowedBandwidth)
+				break;
+			desiredProfileIndex = upper;
+		}
+		if(getRampedUpProfileIndex(desiredProfileIndex,periodId) == desiredProfileIndex)
+			exitPhase = true;
+	}
+	mFastStartFragments++;
+	mFastStartLastBuffer = bufferValue;
+	if(mFastStartFragments >= mFastStartConfig.maxFragments)
+	{
+		exitPhase = true;
+	}
+	if(desiredProfileIndex != currProfileIndex)
+	{
+		AAMPABRLOG_WARN("Fast start ramp up ->currProf:%d newProf:%d nwBandwidth:%ld bufferValue:%lf",
+				currProfileIndex,desiredProfileIndex,nwBandwidth,bufferValue);
+		mhBitrateReason = reason;
+	}
+	newProfileIndex = desiredProfileIndex;
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_FAST_START, reason, desiredProfileIndex,
+		currProfileIndex, nwBandwidth, (int64_t)(bufferValue * 1000), allowedBandwidth, mFastStartFragments,
+		ABRFlightRecorder::hashPeriodId(periodId));
+	if(exitPhase)
+	{
+		AAMPABRLOG_INFO("[%s][%d] Fast start done after %d fragments at profile %d",__FUNCTION__,__LINE__,mFastStartFragments,desiredProfileIndex);
+		mFastStartReason = eAAMP_BITRATE_CHANGE_MAX;
+	}
+	return true;
+}
+
+/**
+ * @brief Check whether an in-flight fragment download should be abandoned
+ */
+
+bool HybridABRManager::ShouldAbandonFragment(long bytesSoFar,long elapsedMs,long expectedBytes,double bufferValue,int currProfileIndex,int &newProfileIndex,const std::string& periodId)
+{
+	ABR_PROFILE_API(eAPI_SHOULD_ABANDON_FRAGMENT);
+	ConfigReader abrConfig(mAbrConfig);
+	bool abandon = false;
+	int lowerProfileIndex = currProfileIndex;
+	long currentBandwidth = getBandwidthOfProfile(currProfileIndex);
+	if(elapsedMs >= DEFAULT_ABR_ABANDON_MIN_ELAPSED_MS && expectedBytes > bytesSoFar && currentBandwidth > 0)
+	{
+		// No byte yet: as if one byte came, the time to complete is then far beyond any buffer
+		double throughputBps = (double)std::max(bytesSoFar, 1L) * 8000 / elapsedMs;
+		double timeToCompleteMs = (double)(expectedBytes - bytesSoFar) * 8000 / throughputBps;
+		double timeToStallMs = bufferValue * 1000;
+		if(timeToCompleteMs > timeToStallMs)
+		{
+			// Fragment duration from its size at the profile bitrate, a lower profile costs
+			// its bitrate over the same duration
+			double fragmentDurationMs = (double)expectedBytes * 8000 / currentBandwidth;
+			int candidate = currProfileIndex;
+			double candidateTimeMs = timeToCompleteMs;
+			while(true)
+			{
+				int lower = getRampedDownProfileIndex(candidate,periodId);
+				if(lower == candidate)
+					break;
+				candidate = lower;
+				candidateTimeMs = getBandwidthOfProfile(candidate) * fragmentDurationMs / throughputBps;
+				if(candidateTimeMs <= timeToStallMs * DEFAULT_ABR_ABANDON_BUFFER_SAFETY)
+					break;
+			}
+			// The lowest profile is still taken if it shortens the stall
+			if(candidate != currProfileIndex && candidateTimeMs < timeToCompleteMs)
+			{
+				abandon = true;
+				lowerProfileIndex = candidate;
+				AAMPABRLOG_WARN("Abandon fragment of profile %d at %ld/%ld bytes after %ld ms, complete in %.0f ms, stall in %.0f ms, re-request profile %d in %.0f ms",
+					currProfileIndex, bytesSoFar, expectedBytes, elapsedMs, timeToCompleteMs, timeToStallMs, lowerProfileIndex, candidateTimeMs);
+			}
+		}
+	}
+	if(abandon)
+	{
+		newProfileIndex = lowerProfileIndex;
+	}
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_ABANDON_CHECK, abandon ? eAAMP_BITRATE_CHANGE_BY_RAMPDOWN : 0, abandon ? lowerProfileIndex : -1,
+		bytesSoFar, elapsedMs, expectedBytes, (int64_t)(bufferValue * 1000), currProfileIndex, ABRFlightRecorder::hashPeriodId(periodId));
+	return abandon;
 }
 
 /**
@@ -358,6 +792,10 @@ void HybridABRManager::CheckRampdownFromSteadyState(int currProfileIndex, int &n
 
 long long HybridABRManager::ABRGetCurrentTimeMS(void)
 {
+	if (mClock)
+	{
+		return mClock(mClockContext);
+	}
 	struct timeval t;
 	gettimeofday(&t, NULL);
 	return (long long)(t.tv_sec*1e3 + t.tv_usec*1e-3);
@@ -416,6 +854,7 @@ bool HybridABRManager::IsABRDataGoodToEstimate(long time_diff) {
  */
 void HybridABRManager::CheckLLDashABRSpeedStoreSize(struct SpeedCache *speedcache,long &bitsPerSecond,long time_now,long total_dl_diff,long time_diff,long currentTotalDownloaded)
 {
+	ABR_PROFILE_API(eAPI_CHECK_LL_SPEED_STORE_SIZE);
 	speedcache->last_sample_time_val = time_now;
 	//speed @ bits per second
 	speedcache->speed_now = ((long)(total_dl_diff / time_diff)* 8000);
@@ -423,6 +862,7 @@ void HybridABRManager::CheckLLDashABRSpeedStoreSize(struct SpeedCache *speedcach
 	double weight = std::sqrt((double)total_dl_diff);
 	speedcache->weightedBitsPerSecond += weight * speedcache->speed_now;
 	speedcache->totalWeight += weight;
+	speedcache->mChunkSpeedData.reserve(MAX_LOW_LATENCY_DASH_ABR_SPEEDSTORE_SIZE + 1);
 	speedcache->mChunkSpeedData.push_back(std::make_pair(weight ,speedcache->speed_now));
 	
 	if(speedcache->mChunkSpeedData.size() > MAX_LOW_LATENCY_DASH_ABR_SPEEDSTORE_SIZE)
@@ -435,5 +875,84 @@ void HybridABRManager::CheckLLDashABRSpeedStoreSize(struct SpeedCache *speedcach
 	}
 
 	speedcache->prevSampleTotalDownloaded = currentTotalDownloaded;
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_LL_CHUNK_SAMPLE, 0, 0,
+		time_now, total_dl_diff, time_diff, currentTotalDownloaded, bitsPerSecond);
+}
+
+
+/**
+ * @brief Count a profile change applied by the player
+ */
+void HybridABRManager::ReportProfileChange(int currProfileIndex, int newProfileIndex, BitrateChangeReason reason)
+{
+	ABR_PROFILE_API(eAPI_REPORT_PROFILE_CHANGE);
+	if(currProfileIndex != newProfileIndex)
+	{
+		mMetrics.recordSwitch(reason, getBandwidthOfProfile(currProfileIndex), getBandwidthOfProfile(newProfileIndex));
+	}
+	mMetrics.recordProfileTime(newProfileIndex, getBandwidthOfProfile(newProfileIndex), ABRGetCurrentTimeMS());
+	mFlightRecorder.record(ABRFlightRecorder::eRECORD_PROFILE_CHANGE, reason, newProfileIndex,
+		currProfileIndex, newProfileIndex);
 }
 
+/**
+ * @brief Account a fragment in the QoE score and the time per profile
+ */
+void HybridABRManager::ReportFragment(int profileIndex, long fragmentDurationMs)
+{
+	ABR_PROFILE_API(eAPI_REPORT_FRAGMENT);
+	long long now = ABRGetCurrentTimeMS();
+	long bandwidth = getBandwidthOfProfile(profileIndex);
+	mQoEScore.onFragment(bandwidth, fragmentDurationMs, now);
+	mMetrics.recordProfileTime(profileIndex, bandwidth, now);
+}
+
+/**
+ * @brief Account a stall in the QoE score
+ */
+void HybridABRManager::ReportStall(long stallDurationMs)
+{
+	ABR_PROFILE_API(eAPI_REPORT_STALL);
+	mQoEScore.onStall(stallDurationMs, ABRGetCurrentTimeMS());
+}
+
+/**
+ * @brief Account the startup delay in the QoE score
+ */
+void HybridABRManager::ReportStartup(long startupDelayMs)
+{
+	mQoEScore.onStartup(startupDelayMs, ABRGetCurrentTimeMS());
+}
+
+/**
+ * @brief Get the QoE score of the session
+ */
+void HybridABRManager::GetSessionQoE(ABRQoEScore::Score &score)
+{
+	mQoEScore.getSessionScore(score);
+}
+
+/**
+ * @brief Get the QoE score of the rolling window
+ */
+void HybridABRManager::GetWindowQoE(ABRQoEScore::Score &score)
+{
+	mQoEScore.getWindowScore(ABRGetCurrentTimeMS(), score);
+}
+
+/**
+ * @brief Set the QoE weights and window
+ */
+void HybridABRManager::SetQoEConfig(const ABRQoEScore::Weights &weights, long long windowMs)
+{
+	mQoEScore.setWeights(weights);
+	mQoEScore.setWindow(windowMs);
+}
+
+/**
+ * @brief Reset the QoE score
+ */
+void HybridABRManager::ResetQoE()
+{
+	mQoEScore.reset();
+}
@@ -27,6 +27,33 @@
 #include <string>
 #include <cstdio>
 #include "ABRManager.h"
+#include "ABRQoEScore.h"
+#include "ABRRcuValue.h"
+#include "ABRThroughputAggregator.h"
+
+/**
+ * @struct SpeedCache
+ * @brief Low latency chunk speed state of a download, kept by the caller of
+ * HybridABRManager::CheckLLDashABRSpeedStoreSize across its reads
+ */
+struct SpeedCache
+{
+	long last_sample_time_val;		/**< Time of the last speed sample in ms */
+	long prev_dlnow;			/**< Bytes downloaded at the previous read */
+	long prevSampleTotalDownloaded;		/**< Bytes downloaded at the last speed sample */
+	long totalDownloaded;			/**< Bytes downloaded since the start */
+	long speed_now;				/**< Last speed sample in bps */
+	long start_val;				/**< Start time of the download in ms */
+	bool bStart;				/**< Download started */
+
+	double totalWeight;			/**< Sum of the chunk weights */
+	double weightedBitsPerSecond;		/**< Sum of the weighted chunk speeds */
+	std::vector< std::pair<double,long> > mChunkSpeedData;	/**< Weight and speed of the recent chunks */
+
+	SpeedCache() : last_sample_time_val(0), prev_dlnow(0), prevSampleTotalDownloaded(0), totalDownloaded(0), speed_now(0), start_val(0), bStart(false) , totalWeight(0), weightedBitsPerSecond(0), mChunkSpeedData()
+	{
+	}
+};
 
 class HybridABRManager:public ABRManager
 {
@@ -108,6 +135,55 @@ class HybridABRManager:public ABRManager
 		};
 
 
+		/**
+		 * @brief When and how to fetch the next fragments
+		 */
+		struct FetchAdvice
+		{
+			long long fetchTimeMs;  /**< Time to start the next fetch, on the ABRGetCurrentTimeMS clock */
+			int parallelFetches;    /**< Number of fragments to fetch in parallel */
+			bool paced;             /**< The fetch follows a pacing wait, its sample is a paced sample */
+		};
+
+		/**
+		 * @brief Snapshot of the Linux tcp_info of the download socket (getsockopt TCP_INFO),
+		 *  0 for the fields the socket does not provide
+		 */
+		struct TcpInfoSample
+		{
+			long long bytesReceived; /**< tcpi_bytes_received, gives the rate when deliveryRate is 0 */
+			long deliveryRate;      /**< tcpi_delivery_rate * 8 in bps, 0 on a receiving socket */
+			bool appLimited;        /**< tcpi_delivery_rate_app_limited */
+			long rttUs;             /**< tcpi_rtt (or tcpi_rcv_rtt on a receiving socket) in us */
+			long cwnd;              /**< tcpi_snd_cwnd of the sending side, 0 if unknown */
+			long ssthresh;          /**< tcpi_snd_ssthresh of the sending side, 0 if unknown */
+			long totalRetrans;      /**< tcpi_total_retrans */
+		};
+
+		/**
+		 * @brief Limits of the fast start phase following a tune or seek
+		 */
+		struct FastStartConfig
+		{
+			int maxStep;            /**< Maximum number of profiles climbed in one decision */
+			int maxFragments;       /**< Number of fragments after which the phase ends */
+		};
+
+		/**
+		 * @brief Backoff of the buffer full rampup probes of CheckRampupFromSteadyState
+		 */
+		struct RampupBackoffConfig
+		{
+			int baseCount;          /**< Buffer checks before a probe after a successful one, 0 for abrCacheLength */
+			int factor;             /**< Growth of the buffer checks after each failed probe */
+			int maxCount;           /**< Maximum buffer checks between two probes */
+		};
+
+		/**
+		 * @brief Constructor, with an empty configuration until ReadPlayerConfig
+		 */
+		HybridABRManager();
+
 		int mABRHighBufferCounter;	    /**< ABR High buffer counter */
 		int mABRLowBufferCounter;	    /**< ABR Low Buffer counter */
 
@@ -135,11 +211,27 @@ class HybridABRManager:public ABRManager
 	public:
 
 		/** @brief Read Config values
+		 *   Publishes a new immutable configuration snapshot, may be called
+		 *   from any thread while the session is running. Calls in progress
+		 *   finish with the previous snapshot.
 		 *   @params AampAbrConfig struct
 		 *  @return none
 		 */
 		void ReadPlayerConfig(AampAbrConfig *mAampAbrConfig);
 
+		/**
+		 * @brief Get the configuration of this instance
+		 *  @return copy of the current configuration
+		 */
+		AampAbrConfig GetPlayerConfig() const { return mAbrConfig.get(); }
+
+		/**
+		 * @brief Get the version of the configuration, 1 before the first
+		 *  ReadPlayerConfig and incremented by each one
+		 *  @return configuration version
+		 */
+		unsigned GetPlayerConfigVersion() const { return mAbrConfig.version(); }
+
 
 		/**
 		 * @brief function to update downloadbps based on abrthreshold size
@@ -160,6 +252,119 @@ class HybridABRManager:public ABRManager
 		 */
 		void UpdateABRBitrateDataBasedOnCacheLength(std::vector < std::pair<long long,long> > &mAbrBitrateData ,long downloadbps,bool LowLatencyMode );
 
+		/**
+		 * @brief to update Bitrate Data, with a sample of a download that may have started
+		 *  after a pacing wait. A paced sample is stored as measured and marked: the
+		 *  connection restarted from idle, it weighs half in UpdateABRBitrateDataBasedOnCacheOutlier.
+		 * @params BitrateData vector
+		 * @params download Bitrate
+		 * @params pacedSample - the download followed a pacing wait (FetchAdvice::paced)
+		 * @return none
+		 */
+		void UpdateABRBitrateDataBasedOnCacheLength(std::vector < std::pair<long long,long> > &mAbrBitrateData ,long downloadbps,bool LowLatencyMode ,bool pacedSample);
+
+		/**
+		 * @brief A fragment download starts, on any download thread. The link throughput is
+		 *  measured over the busy periods of the concurrent downloads instead of per download.
+		 * @return Transfer id, -1 if too many downloads are active (use CheckAbrThresholdSize then)
+		 */
+		int BeginTransfer();
+
+		/**
+		 * @brief Bytes received so far by a download, needed when the downloads overlap without
+		 *  the link going idle
+		 * @params transferId - id returned by BeginTransfer
+		 * @params bytesSoFar - bytes received so far
+		 * @return none
+		 */
+		void ProgressTransfer(int transferId,long bytesSoFar);
+
+		/**
+		 * @brief A fragment download ends. If it ends the busy period of the link and the period
+		 *  downloaded more than abrThresholdSize, the link throughput of the period is added to
+		 *  the bitrate data as a download sample.
+		 * @params transferId - id returned by BeginTransfer
+		 * @params bytes - bytes received by the download
+		 * @params BitrateData vector
+		 * @return long - link throughput added to the bitrate data, -1 if none
+		 */
+		long EndTransfer(int transferId,long bytes,std::vector < std::pair<long long,long> > &mAbrBitrateData);
+
+		/**
+		 * @brief Account a tcp_info snapshot of the download socket, may be called several times
+		 *  per fragment. Rate samples taken while the sender is in slow start with a cwnd limited
+		 *  rate, or app limited, get a lower weight. The link is congested when the RTT reaches
+		 *  twice the minimum RTT or a retransmission happened since the previous snapshot.
+		 * @params sample - tcp_info snapshot
+		 * @return bool - true if the link is congested
+		 */
+		bool ReportTcpInfo(const TcpInfoSample &sample);
+
+		/**
+		 * @brief Fuse the fragment based estimate with the tcp_info rate. Without recent tcp_info
+		 *  the fragment estimate is returned as is, on congestion the lower of the two, otherwise
+		 *  a blend giving the tcp_info rate up to half of the weight as its samples accumulate.
+		 * @params fragmentEstimate - estimate of UpdateABRBitrateDataBasedOnCacheOutlier, -1 if none
+		 * @return long - fused estimate, -1 if none
+		 */
+		long FuseTcpInfoEstimate(long fragmentEstimate);
+
+		/**
+		 * @brief Advise when to fetch the next fragment and how many fragments to fetch in parallel
+		 *  Below abrMinBuffer fragments are fetched now, in parallel if the network bandwidth allows
+		 *  it, up to abrMaxBuffer one by one, and above abrMaxBuffer after the buffer drained
+		 *  by one fragment.
+		 * @params bufferValue - buffer availability in seconds
+		 * @params fragmentDuration - fragment duration in seconds
+		 * @params nwBandwidth - current network bandwidth estimate, -1 if none
+		 * @params profileBandwidth - bitrate of the profile to fetch
+		 * @params advice - updated with the advice
+		 * @return none
+		 */
+		void GetFetchAdvice(double bufferValue,double fragmentDuration,long nwBandwidth,long profileBandwidth,FetchAdvice &advice);
+
+		/**
+		 * @brief Start the fast start phase, on a tune or a seek
+		 * @params reason - eAAMP_BITRATE_CHANGE_BY_TUNE or eAAMP_BITRATE_CHANGE_BY_SEEK, other reasons are ignored
+		 * @return none
+		 */
+		void StartFastStart(BitrateChangeReason reason);
+
+		/**
+		 * @brief Set the limits of the fast start phase
+		 * @params config - maximum step and number of fragments
+		 * @return none
+		 */
+		void SetFastStartConfig(const FastStartConfig &config);
+
+		/**
+		 * @brief Set the backoff of the buffer full rampup probes
+		 * @params config - base count, growth factor and cap of the buffer checks between probes
+		 * @return none
+		 */
+		void SetRampupBackoffConfig(const RampupBackoffConfig &config);
+
+		/**
+		 * @brief Check whether the fast start phase is running
+		 * @return bool - true during the fast start phase
+		 */
+		bool IsFastStartActive() const;
+
+		/**
+		 * @brief Get Desired Profile during the fast start phase, called once per fragment
+		 *  Ramps up, possibly by several profiles, to the highest profile the network bandwidth
+		 *  supports while the buffer keeps growing: the part of the bandwidth a profile may use
+		 *  grows from 50% on an empty buffer to 100% at abrMaxBuffer. The phase ends after
+		 *  maxFragments fragments, when the buffer shrinks, reaches abrMaxBuffer or the top profile.
+		 * @params currProfileIndex - current profile
+		 * @params newProfileIndex - updated with the fast start profile, unchanged if the phase is not running
+		 * @params nwBandwidth - current network bandwidth estimate
+		 * @params bufferValue - buffer availability in seconds
+		 * @params mhBitrateReason - updated with the tune / seek reason if the profile changes
+		 * @return bool - true if the fast start phase decided the profile
+		 */
+		bool GetFastStartProfileIndex(int currProfileIndex,int &newProfileIndex,long nwBandwidth,double bufferValue,BitrateChangeReason &mhBitrateReason,const std::string& periodId= std::string());
+
 		/**
 		 * @brief Update Bitrate Data based on ABR CacheLife
 		 * @params BitrateData vector
@@ -169,7 +374,7 @@ class HybridABRManager:public ABRManager
 		void UpdateABRBitrateDataBasedOnCacheLife(std::vector < std::pair<long long,long> > &mAbrBitrateData , std::vector< long> &tmpData);
 
 		/**
-		 * @@brief Update Bitrate Data based on ABRCacheOutlier
+		 * @@brief Update Bitrate Data based on ABRCacheOutlier, paced samples weigh half in the average
 		 * @params tmpData vector
 		 * @return none
 		 */
@@ -213,6 +418,9 @@ class HybridABRManager:public ABRManager
 		 * @params bufferValue -Biffer availability
 		 * @params newBandwidth - bitrate of new profileIdx
 		 * @params BitrateChangeReason is getting updated only if rampup occur
+		 * @params mMaxBufferCountCheck - updated on a rampup with the buffer checks before the next probe:
+		 *  the base count after a successful probe (its profile was kept), grown by the backoff factor
+		 *  up to the cap after a failed one
 		 * @return none
 		 */
 
@@ -227,9 +435,23 @@ class HybridABRManager:public ABRManager
 		 */
 		void CheckRampdownFromSteadyState(int currProfileIndex, int &newProfileIndex,BitrateChangeReason &mBitrateReason,int mABRLowBufferCounter,const std::string& periodId= std::string());
 
+		/*
+		 * @brief function to check whether an in-flight fragment download should be abandoned
+		 *  and re-requested at a lower profile, comparing its time to complete at the
+		 *  measured throughput with the time to stall
+		 * @params bytesSoFar - bytes received so far
+		 * @params elapsedMs - time since the request in ms
+		 * @params expectedBytes - size of the fragment in bytes
+		 * @params bufferValue - buffer availability in seconds
+		 * @params currProfileIndex - profile of the fragment
+		 * @params newProfileIndex - updated with the profile to re-request at, if abandoned
+		 * @return bool - true to abandon the download
+		 */
+		bool ShouldAbandonFragment(long bytesSoFar,long elapsedMs,long expectedBytes,double bufferValue,int currProfileIndex,int &newProfileIndex,const std::string& periodId= std::string());
+
 		/**
 		 * @brief aampabr_GetCurrentTimeMS
-		 *
+		 *  @return wall clock time in ms, or the time of the clock set by setClock
 		 */
 		long long ABRGetCurrentTimeMS(void);
 
@@ -276,5 +498,99 @@ class HybridABRManager:public ABRManager
 		 */
 		bool IsABRDataGoodToEstimate(long time_diff);
 
+		/**
+		 * @brief Report a profile change applied by the player, for the metrics. Call it for every
+		 * applied change, suggested by the ABR functions or made by the player (tune, seek,
+		 * trickplay): the ABR functions do not count the profiles they suggest. The time since
+		 * the previous report is accounted to the profile played until then.
+		 * @param currProfileIndex - profile before the change
+		 * @param newProfileIndex - profile after the change
+		 * @param reason - reason of the change
+		 * @return None
+		 */
+		void ReportProfileChange(int currProfileIndex, int newProfileIndex, BitrateChangeReason reason);
+
+		/**
+		 * @brief Report a fragment handed to playback, for the QoE score and the time spent
+		 * per profile of the metrics
+		 * @param profileIndex - profile of the fragment
+		 * @param fragmentDurationMs - fragment duration in ms
+		 * @return None
+		 */
+		void ReportFragment(int profileIndex, long fragmentDurationMs);
+
+		/**
+		 * @brief Report a playback stall (rebuffering), for the QoE score
+		 * @param stallDurationMs - stall duration in ms
+		 * @return None
+		 */
+		void ReportStall(long stallDurationMs);
+
+		/**
+		 * @brief Report the startup delay of the session, for the QoE score
+		 * @param startupDelayMs - time from tune to first frame in ms
+		 * @return None
+		 */
+		void ReportStartup(long startupDelayMs);
+
+		/**
+		 * @brief Get the QoE score of the session
+		 * @param[out] score - QoE score and its terms
+		 * @return None
+		 */
+		void GetSessionQoE(ABRQoEScore::Score &score);
+
+		/**
+		 * @brief Get the QoE score of the rolling window
+		 * @param[out] score - QoE score and its terms
+		 * @return None
+		 */
+		void GetWindowQoE(ABRQoEScore::Score &score);
+
+		/**
+		 * @brief Set the QoE weights and rolling window length
+		 * @param weights - QoE weights
+		 * @param windowMs - rolling window length in ms
+		 * @return None
+		 */
+		void SetQoEConfig(const ABRQoEScore::Weights &weights, long long windowMs);
+
+		/**
+		 * @brief Reset the QoE score, on a new session
+		 * @return None
+		 */
+		void ResetQoE();
+
+	private:
+		typedef ABRRcuValue<AampAbrConfig>::Reader ConfigReader;
+
+		ABRQoEScore mQoEScore;                /**< Online QoE score of the session */
+		ABRRcuValue<AampAbrConfig> mAbrConfig; /**< Configuration snapshots of this instance */
+		RampupBackoffConfig mRampupBackoffConfig; /**< Backoff of the buffer full rampup probes */
+		int mRampupBackoffCount;              /**< Buffer checks before the next probe, 0 for the base count */
+		long mRampupProbeBandwidth;           /**< Bitrate of the last probe, 0 if none */
+		std::vector< std::pair<long long,long> > mPacedSamples; /**< Time and bps of the paced samples still cached */
+		std::vector<long> mPacedScratch;      /**< Sorted bps of the paced samples, scratch of the average */
+		ABRThroughputAggregator mThroughputAggregator; /**< Busy periods of the concurrent downloads */
+
+		/**
+		 * @brief tcp_info state of the download socket
+		 */
+		struct TcpInfoState
+		{
+			long long lastTimeMs;   /**< Time of the last snapshot, 0 if none */
+			long long lastBytes;    /**< Bytes received at the last snapshot */
+			long lastRetrans;       /**< Retransmissions at the last snapshot */
+			long minRttUs;          /**< Minimum RTT seen, 0 if none */
+			double rateBps;         /**< Smoothed rate */
+			int rateSamples;        /**< Rate samples folded into rateBps */
+			bool congested;         /**< Congestion seen by the last snapshot */
+		};
+		TcpInfoState mTcpInfo;                /**< tcp_info state, see ReportTcpInfo */
+		FastStartConfig mFastStartConfig;     /**< Limits of the fast start phase */
+		BitrateChangeReason mFastStartReason; /**< Reason of the running fast start phase, eAAMP_BITRATE_CHANGE_MAX if none */
+		int mFastStartFragments;              /**< Fragments decided in the fast start phase */
+		double mFastStartLastBuffer;          /**< Buffer at the previous fast start decision */
+
 };
 #endif
@@ -0,0 +1,365 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRAllocCheck.cpp
+ * @brief Check that the per fragment decision and estimator calls do not allocate
+ *
+ * Usage: abr-alloc-check [-n iterations] [-v]
+ *
+ * Replaces the global operator new and delete with counting ones. After the
+ * setup (profiles, configuration, updateProfile) and a warmup that brings
+ * the estimator vectors to their steady size, each group of per fragment
+ * calls runs the given number of iterations, default 1000, and any heap
+ * allocation is reported. Exits 1 if a group allocated.
+ *
+ * The ABRManager logger is disabled and the logging flags of the
+ * configuration are off: the player logger is not part of the check.
+ *
+ * -n iterations: iterations of each group after the warmup
+ * -v:            print the allocations of every group
+ ***************************************************/
+
+#include "ABRController.h"
+#include "HybridABRManager.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Allocations while counting, counted from every thread
+ */
+static std::atomic<long> gAllocations(0);
+static std::atomic<bool> gCounting(false);
+
+static void* countedAlloc(size_t size) {
+  if (gCounting.load(std::memory_order_relaxed)) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  try { return countedAlloc(size); } catch (...) { return NULL; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  try { return countedAlloc(size); } catch (...) { return NULL; }
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { free(ptr); }
+
+/**
+ * @brief Profile bitrates of the check ladder
+ */
+static const long LADDER[] = { 500000, 1000000, 2000000, 3000000, 4500000, 6000000 };
+static const int LADDER_SIZE = sizeof(LADDER) / sizeof(LADDER[0]);
+
+/**
+ * @brief Estimator configuration, player defaults
+ */
+static const HybridABRManager::AampAbrConfig CHECK_CONFIG = { 5000, 3, 6, 2, 6000, 10, 5, 5000000, false, false, false, false };
+
+static const long FRAGMENT_MS = 2000;
+static const int WARMUP_ITERATIONS = 64;
+static const int DEFAULT_ITERATIONS = 1000;
+
+/**
+ * @brief State of the checked calls, set up before counting
+ */
+struct Context {
+  HybridABRManager abr;
+  HybridABRManager hysteresisAbr;
+  ABRController controller;
+  std::vector<std::pair<long long, long> > bitrateData;
+  std::vector<long> samples;
+  SpeedCache speedCache;
+  std::string periodId;
+  std::string unknownPeriodId;
+  long long clockMs;
+  long long bytesReceived;
+  int profile;
+
+  Context() : periodId("0"), unknownPeriodId("unknown"), clockMs(1000), bytesReceived(0), profile(0) {}
+};
+
+/**
+ * @brief Virtual clock, advanced by the checks
+ */
+static long long virtualClock(void* context) {
+  return static_cast<Context*>(context)->clockMs;
+}
+
+/**
+ * @brief Network rate of an iteration, swings across the ladder
+ */
+static long rateAt(int iteration) {
+  return LADDER[(iteration / 3) % LADDER_SIZE] + 250000;
+}
+
+static void setupManager(HybridABRManager& abr, Context& context) {
+  HybridABRManager::AampAbrConfig config = CHECK_CONFIG;
+  abr.ReadPlayerConfig(&config);
+  abr.setClock(virtualClock, &context);
+  for (int i = 0; i < LADDER_SIZE; i++) {
+    abr.emplaceProfile(false, LADDER[i], 0, 0, context.periodId, i);
+  }
+  abr.emplaceProfile(true, 200000, 0, 0, context.periodId, LADDER_SIZE);
+  abr.updateProfile();
+}
+
+static void checkEstimator(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  context.clockMs += FRAGMENT_MS;
+  long rate = rateAt(iteration);
+  long downloadbps = abr.CheckAbrThresholdSize((int)(rate / 8 * 2), 2000, LADDER[context.profile],
+    (int)FRAGMENT_MS, HybridABRManager::eCURL_ABORT_REASON_NONE);
+  abr.UpdateABRBitrateDataBasedOnCacheLength(context.bitrateData, downloadbps, false, (iteration & 1) != 0);
+  context.samples.clear();
+  abr.UpdateABRBitrateDataBasedOnCacheLife(context.bitrateData, context.samples);
+  if (!context.samples.empty()) {
+    abr.UpdateABRBitrateDataBasedOnCacheOutlier(context.samples);
+  }
+}
+
+static void checkLowLatency(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  long bitsPerSecond = 0;
+  long timeDiff = 200;
+  long bytes = rateAt(iteration) / 8 / 5;
+  context.clockMs += timeDiff;
+  if (abr.IsABRDataGoodToEstimate(timeDiff)) {
+    abr.CheckLLDashABRSpeedStoreSize(&context.speedCache, bitsPerSecond, (long)context.clockMs, bytes, timeDiff,
+      context.speedCache.prevSampleTotalDownloaded + bytes);
+  }
+}
+
+static void checkTransfers(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  long bytes = rateAt(iteration) / 8;
+  int video = abr.BeginTransfer();
+  int audio = abr.BeginTransfer();
+  context.clockMs += 500;
+  abr.ProgressTransfer(video, bytes / 4);
+  context.clockMs += 500;
+  abr.EndTransfer(audio, bytes / 8, context.bitrateData);
+  abr.EndTransfer(video, bytes, context.bitrateData);
+}
+
+static void checkTcpInfo(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  HybridABRManager::TcpInfoSample sample = HybridABRManager::TcpInfoSample();
+  context.clockMs += 100;
+  context.bytesReceived += rateAt(iteration) / 80;
+  sample.bytesReceived = context.bytesReceived;
+  sample.rttUs = 20000 + (iteration % 7) * 5000;
+  sample.totalRetrans = iteration / 50;
+  abr.ReportTcpInfo(sample);
+  abr.FuseTcpInfoEstimate(rateAt(iteration));
+}
+
+static void checkDecisions(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  long rate = rateAt(iteration);
+  int current = context.profile;
+  long currentBandwidth = abr.getBandwidthOfProfile(current);
+  context.clockMs += FRAGMENT_MS;
+  if (abr.CheckProfileChange(iteration * FRAGMENT_MS / 1000.0, current, rate)) {
+    context.profile = abr.getProfileIndexByBitrateRampUpOrDown(current, currentBandwidth, rate, 2, context.periodId);
+  }
+  abr.getProfileIndexByQualityRampUpOrDown(current, currentBandwidth, rate, 2, context.periodId);
+  abr.getProfileIndexByQuality(rate, context.periodId);
+  abr.getRampedUpProfileIndex(current, context.periodId);
+  abr.getRampedDownProfileIndex(current, context.periodId);
+  abr.isProfileIndexBitrateLowest(current, context.periodId);
+  abr.getMaxBandwidthProfile(context.periodId);
+  abr.IsLowestProfile(current, false);
+  abr.getDataSaverBandwidthCap();
+
+  // Unknown period, eg. before the profiles of a new period are added
+  abr.getRampedDownProfileIndex(current, context.unknownPeriodId);
+  abr.getProfileIndexByBitrateRampUpOrDown(current, currentBandwidth, rate, 2, context.unknownPeriodId);
+}
+
+static void checkHysteresis(Context& context, int iteration) {
+  HybridABRManager& abr = context.hysteresisAbr;
+  long rate = rateAt(iteration);
+  int current = context.profile;
+  context.clockMs += FRAGMENT_MS;
+  abr.getProfileIndexByBitrateRampUpOrDown(current, abr.getBandwidthOfProfile(current), rate, 2, context.periodId);
+  abr.getProfileIndexByBitrateRampUpOrDown(current, abr.getBandwidthOfProfile(current), rate, 2, context.unknownPeriodId);
+}
+
+static void checkBuffer(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  int current = context.profile;
+  int desired = abr.getRampedUpProfileIndex(current, context.periodId);
+  double bufferValue = (iteration % 20) + 0.5;
+  int maxBufferCountCheck = 3;
+  HybridABRManager::BitrateChangeReason reason = HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR;
+  context.clockMs += FRAGMENT_MS;
+  abr.GetDesiredProfileOnBuffer(current, desired, bufferValue, 6, context.periodId);
+  desired = current;
+  abr.CheckRampupFromSteadyState(current, desired, rateAt(iteration), bufferValue, abr.getBandwidthOfProfile(current),
+    reason, maxBufferCountCheck, context.periodId);
+  desired = current;
+  abr.CheckRampdownFromSteadyState(current, desired, reason, iteration % 5, context.periodId);
+}
+
+static void checkFastStart(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  int desired = context.profile;
+  HybridABRManager::BitrateChangeReason reason = HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR;
+  if (iteration % 10 == 0) {
+    abr.StartFastStart(HybridABRManager::eAAMP_BITRATE_CHANGE_BY_SEEK);
+  }
+  context.clockMs += FRAGMENT_MS;
+  if (abr.IsFastStartActive()) {
+    abr.GetFastStartProfileIndex(context.profile, desired, rateAt(iteration), iteration % 10, reason, context.periodId);
+  }
+}
+
+static void checkFetch(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  int current = context.profile;
+  int newProfile = current;
+  HybridABRManager::FetchAdvice advice;
+  long expectedBytes = abr.getBandwidthOfProfile(current) / 8 * 2;
+  context.clockMs += FRAGMENT_MS;
+  abr.ShouldAbandonFragment(expectedBytes / 4, 1000 + (iteration % 5) * 500, expectedBytes, 4.0, current, newProfile,
+    context.periodId);
+  abr.GetFetchAdvice((iteration % 30) + 0.5, 2.0, rateAt(iteration), abr.getBandwidthOfProfile(current), advice);
+}
+
+static void checkReports(Context& context, int iteration) {
+  HybridABRManager& abr = context.abr;
+  ABRQoEScore::Score score;
+  int current = context.profile;
+  context.clockMs += FRAGMENT_MS;
+  abr.ReportFragment(current, FRAGMENT_MS);
+  abr.reportDownloadedBytes(abr.getBandwidthOfProfile(current) / 4);
+  if (iteration % 7 == 0) {
+    abr.ReportProfileChange(current, abr.getRampedDownProfileIndex(current, context.periodId),
+      HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR);
+  }
+  if (iteration % 50 == 0) {
+    abr.ReportStall(500);
+  }
+  abr.GetWindowQoE(score);
+}
+
+static void checkController(Context& context, int iteration) {
+  ABRController& controller = context.controller;
+  HybridABRManager::TcpInfoSample sample = HybridABRManager::TcpInfoSample();
+  long rate = rateAt(iteration);
+  context.clockMs += FRAGMENT_MS;
+  context.bytesReceived += rate / 8 * 2;
+  sample.bytesReceived = context.bytesReceived;
+  sample.rttUs = 30000;
+  controller.onTcpInfo(sample);
+  controller.onBufferLevel((iteration % 25) + 0.5);
+  controller.onDownloadComplete(rate / 8 * 2, 2000, FRAGMENT_MS);
+  if (iteration % 100 == 99) {
+    controller.onStall(300);
+  }
+}
+
+/**
+ * @brief A group of per fragment calls
+ */
+struct Check {
+  const char* name;
+  void (*run)(Context& context, int iteration);
+};
+
+static const Check CHECKS[] = {
+  { "estimator", checkEstimator },
+  { "low-latency", checkLowLatency },
+  { "transfers", checkTransfers },
+  { "tcp-info", checkTcpInfo },
+  { "decisions", checkDecisions },
+  { "hysteresis", checkHysteresis },
+  { "buffer", checkBuffer },
+  { "fast-start", checkFastStart },
+  { "fetch", checkFetch },
+  { "reports", checkReports },
+  { "controller", checkController },
+};
+static const int CHECK_COUNT = sizeof(CHECKS) / sizeof(CHECKS[0]);
+
+int main(int argc, char* argv[])
+{
+  int iterations = DEFAULT_ITERATIONS;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      iterations = atoi(argv[++i]);
+    } else if (arg == "-v") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "Usage: %s [-n iterations] [-v]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iterations <= 0) {
+    fprintf(stderr, "Invalid iterations %d\n", iterations);
+    return 2;
+  }
+
+  ABRManager::disableLogger();
+  Context* context = new Context();
+  setupManager(context->abr, *context);
+  setupManager(context->hysteresisAbr, *context);
+  ABRManager::HysteresisConfig hysteresis = { 4000, 2000, 0.1, 0.1 };
+  context->hysteresisAbr.setSwitchHysteresis(hysteresis);
+  setupManager(context->controller.getManager(), *context);
+  context->controller.onTune(context->periodId);
+
+  int failed = 0;
+  for (int c = 0; c < CHECK_COUNT; c++) {
+    const Check& check = CHECKS[c];
+    for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+      check.run(*context, i);
+    }
+    gAllocations.store(0);
+    gCounting.store(true);
+    for (int i = 0; i < iterations; i++) {
+      check.run(*context, WARMUP_ITERATIONS + i);
+    }
+    gCounting.store(false);
+    long allocations = gAllocations.load();
+    if (allocations != 0) {
+      failed++;
+    }
+    if (verbose || allocations != 0) {
+      printf("%-12s %ld allocations in %d iterations\n", check.name, allocations, iterations);
+    }
+  }
+  printf("%d of %d groups allocation free\n", CHECK_COUNT - failed, CHECK_COUNT);
+  delete context;
+  return failed ? 1 : 0;
+}
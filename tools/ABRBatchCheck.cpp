@@ -0,0 +1,351 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRBatchCheck.cpp
+ * @brief Parity check and benchmark of the ABRBatchDecision kernels
+ *
+ * Usage: abr-batch-check [-s sessions] [-n steps] [-r seed] [-b sessions] [-v]
+ *
+ * Parity: random ladders (1 to 24 distinct rungs), each session on one of
+ * them with its own ABRManager holding the ladder profiles in random order.
+ * Every step gives each session a random estimate (unknown, exactly a rung,
+ * next to a rung, below or above the ladder, anywhere in between), and
+ * sometimes moves it to a random rung as a player would. The decisions of
+ * every kernel supported by the CPU, of decideOne and of
+ * ABRManager::getProfileIndexByBitrateRampUpOrDown must give the same rungs
+ * and the same up/down consistency counters. Exits 1 on any difference.
+ *
+ * Benchmark: sessions per second of decide() with each kernel, against the
+ * same decisions made by one ABRManager per session in a loop.
+ *
+ * -s sessions: sessions of the parity check, default 512
+ * -n steps:    steps of the parity check, default 200
+ * -r seed:     random seed, default 1
+ * -b sessions: sessions of the benchmark, default 10000, 0 to skip it
+ * -v:          print the first differences
+ ***************************************************/
+
+#include "ABRBatchDecision.h"
+#include "ABRManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const int DEFAULT_SESSIONS = 512;
+static const int DEFAULT_STEPS = 200;
+static const int DEFAULT_BENCH_SESSIONS = 10000;
+static const int LADDER_COUNT = 16;
+static const int MAX_RUNGS = 24;
+static const int BENCH_ROUNDS = 50;
+static const int MAX_REPORTED = 10;
+static const int BENCH_NW_CONSISTENCY_COUNT = 2;
+
+static const ABRBatchDecision::Kernel KERNELS[] = {
+  ABRBatchDecision::eKERNEL_SCALAR,
+  ABRBatchDecision::eKERNEL_SSE42,
+  ABRBatchDecision::eKERNEL_AVX2,
+  ABRBatchDecision::eKERNEL_NEON
+};
+static const int KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
+
+static const char* kernelName(ABRBatchDecision::Kernel kernel) {
+  switch (kernel) {
+    case ABRBatchDecision::eKERNEL_SCALAR: return "scalar";
+    case ABRBatchDecision::eKERNEL_SSE42: return "sse4.2";
+    case ABRBatchDecision::eKERNEL_AVX2: return "avx2";
+    case ABRBatchDecision::eKERNEL_NEON: return "neon";
+    default: return "auto";
+  }
+}
+
+/**
+ * @brief Deterministic random generator (xorshift64*)
+ */
+struct Random {
+  unsigned long long state;
+
+  explicit Random(unsigned long long seed) : state(seed * 2654435761ULL + 1) {}
+
+  unsigned long long next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+  }
+
+  int below(int n) { return (int)(next() % (unsigned long long)n); }
+};
+
+/**
+ * @brief Ladder as added to the batch, and the same profiles in the order given to ABRManager
+ */
+struct Ladder {
+  int id;
+  std::vector<long> profiles;
+  std::vector<int> rungProfiles;
+};
+
+static Ladder makeLadder(ABRBatchDecision& batch, Random& random) {
+  Ladder ladder;
+  int rungs = 1 + random.below(MAX_RUNGS);
+  long bandwidth = 100000 + random.below(400000);
+  for (int i = 0; i < rungs; i++) {
+    ladder.profiles.push_back(bandwidth);
+    bandwidth += 1 + random.below(2000000);
+  }
+  for (int i = rungs - 1; i > 0; i--) {
+    std::swap(ladder.profiles[i], ladder.profiles[random.below(i + 1)]);
+  }
+  ladder.id = batch.addLadder(&ladder.profiles[0], rungs);
+  for (int rung = 0; rung < rungs; rung++) {
+    long rungBandwidth = batch.getRungBandwidth(ladder.id, rung);
+    ladder.rungProfiles.push_back((int)(std::find(ladder.profiles.begin(), ladder.profiles.end(), rungBandwidth) - ladder.profiles.begin()));
+  }
+  return ladder;
+}
+
+/**
+ * @brief A random estimate around the ladder
+ */
+static long randomEstimate(const ABRBatchDecision& batch, int ladderId, Random& random) {
+  int rungs = batch.getRungCount(ladderId);
+  long rung = batch.getRungBandwidth(ladderId, random.below(rungs));
+  switch (random.below(8)) {
+    case 0: return -1;
+    case 1: return rung;
+    case 2: return rung - 1;
+    case 3: return rung + 1;
+    case 4: return random.below((int)batch.getRungBandwidth(ladderId, 0));
+    case 5: return batch.getRungBandwidth(ladderId, rungs - 1) + random.below(10000000);
+    default: return random.below((int)batch.getRungBandwidth(ladderId, rungs - 1) + 1000000);
+  }
+}
+
+static void addProfiles(ABRManager& abr, const Ladder& ladder) {
+  for (size_t i = 0; i < ladder.profiles.size(); i++) {
+    abr.emplaceProfile(false, ladder.profiles[i], 0, 0, std::string(), (int)i);
+  }
+  abr.updateProfile();
+}
+
+/**
+ * @brief Decision state of the sessions for one decision path
+ */
+struct SessionState {
+  std::vector<int> rungs;
+  std::vector<int> upCounts;
+  std::vector<int> downCounts;
+  std::vector<int> chosen;
+
+  explicit SessionState(int sessions) : rungs(sessions, 0), upCounts(sessions, 0), downCounts(sessions, 0), chosen(sessions, 0) {}
+};
+
+static int runParity(int sessions, int steps, unsigned long long seed, bool verbose) {
+  Random random(seed);
+  ABRBatchDecision batch;
+  std::vector<Ladder> ladders;
+  for (int i = 0; i < LADDER_COUNT; i++) {
+    ladders.push_back(makeLadder(batch, random));
+  }
+
+  std::vector<ABRBatchDecision::Kernel> kernels;
+  for (int k = 0; k < KERNEL_COUNT; k++) {
+    if (batch.setKernel(KERNELS[k])) {
+      kernels.push_back(KERNELS[k]);
+    }
+  }
+
+  std::vector<int> ladderIds(sessions);
+  std::vector<ABRManager> managers(sessions);
+  for (int s = 0; s < sessions; s++) {
+    const Ladder& ladder = ladders[random.below(LADDER_COUNT)];
+    ladderIds[s] = ladder.id;
+    addProfiles(managers[s], ladder);
+  }
+
+  std::vector<SessionState> kernelStates(kernels.size(), SessionState(sessions));
+  SessionState oneState(sessions);
+  std::vector<int> managerRungs(sessions, 0);
+  std::vector<long> estimates(sessions);
+  long differences = 0;
+  long decisions = 0;
+
+  for (int step = 0; step < steps; step++) {
+    int nwConsistencyCnt = 1 + random.below(4);
+    for (int s = 0; s < sessions; s++) {
+      estimates[s] = randomEstimate(batch, ladderIds[s], random);
+      if (random.below(20) == 0) {
+        // The player moves the session, eg. a seek or a tune
+        int rung = random.below(batch.getRungCount(ladderIds[s]));
+        for (size_t k = 0; k < kernels.size(); k++) {
+          kernelStates[k].rungs[s] = rung;
+        }
+        oneState.rungs[s] = rung;
+        managerRungs[s] = rung;
+      }
+    }
+
+    for (size_t k = 0; k < kernels.size(); k++) {
+      SessionState& state = kernelStates[k];
+      batch.setKernel(kernels[k]);
+      batch.decide(sessions, &ladderIds[0], &state.rungs[0], &estimates[0], nwConsistencyCnt,
+        &state.upCounts[0], &state.downCounts[0], &state.chosen[0]);
+    }
+
+    for (int s = 0; s < sessions; s++) {
+      int ladderId = ladderIds[s];
+      oneState.chosen[s] = batch.decideOne(ladderId, oneState.rungs[s], estimates[s], nwConsistencyCnt,
+        oneState.upCounts[s], oneState.downCounts[s]);
+
+      ABRManager& abr = managers[s];
+      long currentBandwidth = batch.getRungBandwidth(ladderId, managerRungs[s]);
+      int profile = abr.getProfileIndexByBitrateRampUpOrDown(ladders[ladderId].rungProfiles[managerRungs[s]],
+        currentBandwidth, estimates[s], nwConsistencyCnt);
+      int managerRung = batch.getRung(ladderId, abr.getBandwidthOfProfile(profile));
+
+      bool same = (oneState.chosen[s] == managerRung && oneState.upCounts[s] == abr.getProfileChangeUpCount() &&
+        oneState.downCounts[s] == abr.getProfileChangeDownCount());
+      for (size_t k = 0; k < kernels.size(); k++) {
+        const SessionState& state = kernelStates[k];
+        same = same && state.chosen[s] == managerRung && state.upCounts[s] == abr.getProfileChangeUpCount() &&
+          state.downCounts[s] == abr.getProfileChangeDownCount();
+      }
+      if (!same) {
+        if (verbose && differences < MAX_REPORTED) {
+          printf("step %d session %d: rung %d estimate %ld, ABRManager rung %d up %d down %d, decideOne rung %d up %d down %d\n",
+            step, s, managerRungs[s], estimates[s], managerRung, abr.getProfileChangeUpCount(),
+            abr.getProfileChangeDownCount(), oneState.chosen[s], oneState.upCounts[s], oneState.downCounts[s]);
+          for (size_t k = 0; k < kernels.size(); k++) {
+            printf("  %s rung %d up %d down %d\n", kernelName(kernels[k]), kernelStates[k].chosen[s],
+              kernelStates[k].upCounts[s], kernelStates[k].downCounts[s]);
+          }
+        }
+        differences++;
+      }
+      decisions++;
+
+      for (size_t k = 0; k < kernels.size(); k++) {
+        kernelStates[k].rungs[s] = kernelStates[k].chosen[s];
+      }
+      oneState.rungs[s] = oneState.chosen[s];
+      managerRungs[s] = managerRung;
+    }
+  }
+
+  printf("parity: %ld decisions, kernels", decisions);
+  for (size_t k = 0; k < kernels.size(); k++) {
+    printf(" %s", kernelName(kernels[k]));
+  }
+  printf(", decideOne, ABRManager: %ld differences\n", differences);
+  return differences ? 1 : 0;
+}
+
+static double secondsSince(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void runBenchmark(int sessions, unsigned long long seed) {
+  Random random(seed);
+  ABRBatchDecision batch;
+  std::vector<Ladder> ladders;
+  for (int i = 0; i < LADDER_COUNT; i++) {
+    ladders.push_back(makeLadder(batch, random));
+  }
+  std::vector<int> ladderIds(sessions);
+  for (int s = 0; s < sessions; s++) {
+    ladderIds[s] = ladders[random.below(LADDER_COUNT)].id;
+  }
+  // Estimates of every round drawn up front, out of the timed loops
+  std::vector<long> estimates((size_t)sessions * BENCH_ROUNDS);
+  for (size_t i = 0; i < estimates.size(); i++) {
+    estimates[i] = randomEstimate(batch, ladderIds[i % sessions], random);
+  }
+
+  for (int k = 0; k < KERNEL_COUNT; k++) {
+    if (!batch.setKernel(KERNELS[k])) {
+      continue;
+    }
+    SessionState state(sessions);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+      batch.decide(sessions, &ladderIds[0], &state.rungs[0], &estimates[(size_t)round * sessions],
+        BENCH_NW_CONSISTENCY_COUNT, &state.upCounts[0], &state.downCounts[0], &state.chosen[0]);
+      state.rungs.swap(state.chosen);
+    }
+    double seconds = secondsSince(start);
+    printf("bench: %-8s %12.0f sessions/s\n", kernelName(KERNELS[k]), (double)sessions * BENCH_ROUNDS / seconds);
+  }
+
+  std::vector<ABRManager> managers(sessions);
+  for (int s = 0; s < sessions; s++) {
+    addProfiles(managers[s], ladders[ladderIds[s]]);
+  }
+  std::vector<int> profiles(sessions);
+  for (int s = 0; s < sessions; s++) {
+    profiles[s] = ladders[ladderIds[s]].rungProfiles[0];
+  }
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (int s = 0; s < sessions; s++) {
+      ABRManager& abr = managers[s];
+      profiles[s] = abr.getProfileIndexByBitrateRampUpOrDown(profiles[s], abr.getBandwidthOfProfile(profiles[s]),
+        estimates[(size_t)round * sessions + s], BENCH_NW_CONSISTENCY_COUNT);
+    }
+  }
+  double seconds = secondsSince(start);
+  printf("bench: %-8s %12.0f sessions/s\n", "manager", (double)sessions * BENCH_ROUNDS / seconds);
+}
+
+int main(int argc, char* argv[])
+{
+  int sessions = DEFAULT_SESSIONS;
+  int steps = DEFAULT_STEPS;
+  int benchSessions = DEFAULT_BENCH_SESSIONS;
+  unsigned long long seed = 1;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-s" && i + 1 < argc) {
+      sessions = atoi(argv[++i]);
+    } else if (arg == "-n" && i + 1 < argc) {
+      steps = atoi(argv[++i]);
+    } else if (arg == "-r" && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (arg == "-b" && i + 1 < argc) {
+      benchSessions = atoi(argv[++i]);
+    } else if (arg == "-v") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "Usage: %s [-s sessions] [-n steps] [-r seed] [-b sessions] [-v]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (sessions <= 0 || steps <= 0 || benchSessions < 0) {
+    fprintf(stderr, "Invalid sessions %d, steps %d or benchmark sessions %d\n", sessions, steps, benchSessions);
+    return 2;
+  }
+
+  ABRManager::disableLogger();
+  int result = runParity(sessions, steps, seed, verbose);
+  if (benchSessions > 0) {
+    runBenchmark(benchSessions, seed);
+  }
+  return result;
+}
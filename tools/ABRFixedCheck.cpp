@@ -0,0 +1,246 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRFixedCheck.cpp
+ * @brief Check that FixedABRManager gives the results of ABRManager
+ *
+ * Usage: abr-fixed-check [-n rounds] [-r seed] [-v]
+ *
+ * Each round clears both managers and adds the same random ladder: up to
+ * 4 periods, duplicate bandwidths, iframe tracks (4K or not), random default
+ * bitrates. Two of the period-Ids have the same 32 bit hash, found at
+ * startup, so that colliding periods must stay apart. Every query of the
+ * FixedABRManager API is then compared with ABRManager, for every profile
+ * and period, including a period without profiles, and a sequence of ramp
+ * up/down decisions is run on each period. Exits 1 on any difference.
+ *
+ * -n rounds: number of ladders, default 2000
+ * -r seed:   random seed, default 1
+ * -v:        print the first differences
+ ***************************************************/
+
+#include "FixedABRManager.h"
+#include "ABRManager.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static const int MAX_PROFILES = 16;
+static const int MAX_PERIODS = 4;
+static const int DEFAULT_ROUNDS = 2000;
+static const int RAMP_STEPS = 40;
+static const int MAX_REPORTED = 10;
+
+typedef FixedABRManager<MAX_PROFILES, MAX_PERIODS> CheckedManager;
+
+/**
+ * @brief Deterministic random generator (xorshift64*)
+ */
+struct Random {
+  unsigned long long state;
+
+  explicit Random(unsigned long long seed) : state(seed * 2654435761ULL + 1) {}
+
+  unsigned long long next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+  }
+
+  int below(int n) { return (int)(next() % (unsigned long long)n); }
+};
+
+/**
+ * @brief Comparison of the two managers, counts and reports the differences
+ */
+struct Checker {
+  bool verbose;
+  long checks;
+  long differences;
+
+  explicit Checker(bool v) : verbose(v), checks(0), differences(0) {}
+
+  void expect(long fixed, long reference, int round, const char* query, const std::string& periodId, long arg) {
+    checks++;
+    if (fixed != reference) {
+      if (verbose && differences < MAX_REPORTED) {
+        printf("round %d %s(%ld) period \"%s\": FixedABRManager %ld, ABRManager %ld\n",
+          round, query, arg, periodId.c_str(), fixed, reference);
+      }
+      differences++;
+    }
+  }
+};
+
+/**
+ * @brief Two period-Ids with the same FNV-1a hash
+ */
+static bool findCollision(std::string& first, std::string& second) {
+  std::unordered_map<uint32_t, int> seen;
+  char id[32];
+  for (int i = 0; i < (1 << 24); i++) {
+    snprintf(id, sizeof(id), "period-%d", i);
+    uint32_t hash = CheckedManager::hashPeriodId(id);
+    std::unordered_map<uint32_t, int>::iterator it = seen.find(hash);
+    if (it != seen.end()) {
+      snprintf(id, sizeof(id), "period-%d", it->second);
+      first = id;
+      snprintf(id, sizeof(id), "period-%d", i);
+      second = id;
+      return true;
+    }
+    seen[hash] = i;
+  }
+  return false;
+}
+
+static void runRound(CheckedManager& fixed, ABRManager& reference, const std::vector<std::string>& periodIds,
+  Random& random, int round, Checker& checker) {
+  fixed.clearProfiles();
+  reference.clearProfiles();
+
+  long defaultInitBitrate = 500000 + random.below(4000000);
+  long defaultIframeBitrate = random.below(2) ? 0 : 100000 + random.below(900000);
+  fixed.setDefaultInitBitrate(defaultInitBitrate);
+  reference.setDefaultInitBitrate(defaultInitBitrate);
+  fixed.setDefaultIframeBitrate(defaultIframeBitrate);
+  reference.setDefaultIframeBitrate(defaultIframeBitrate);
+
+  // Up to MAX_PERIODS periods used, the last id of the list is never used
+  int usedPeriods = 1 + random.below(MAX_PERIODS);
+  int profiles = 1 + random.below(MAX_PROFILES);
+  std::vector<long> bandwidths;
+  std::vector<char> hasLadder(periodIds.size(), 0);
+  for (int i = 0; i < profiles; i++) {
+    bool iframe = random.below(5) == 0;
+    // Few distinct bandwidths, so that some are duplicated
+    long bandwidth = (iframe ? 100000 : 300000) + 250000 * random.below(12);
+    bool uhd = random.below(4) == 0;
+    int width = uhd ? 3840 : 1280;
+    int height = uhd ? 2160 : 720;
+    int period = random.below(usedPeriods);
+    const std::string& periodId = periodIds[period];
+    hasLadder[period] |= !iframe;
+    bool added = fixed.addProfile(iframe, bandwidth, width, height, periodId.c_str(), i);
+    checker.expect(added, true, round, "addProfile", periodId, bandwidth);
+    reference.emplaceProfile(iframe, bandwidth, width, height, periodId, i);
+    bandwidths.push_back(bandwidth);
+  }
+  fixed.updateProfile();
+  reference.updateProfile();
+
+  int count = reference.getProfileCount();
+  checker.expect(fixed.getProfileCount(), count, round, "getProfileCount", std::string(), 0);
+  checker.expect(fixed.getLowestIframeProfile(), reference.getLowestIframeProfile(), round, "getLowestIframeProfile", std::string(), 0);
+  checker.expect(fixed.getDesiredIframeProfile(), reference.getDesiredIframeProfile(), round, "getDesiredIframeProfile", std::string(), 0);
+  for (int i = 0; i <= count; i++) {
+    checker.expect(fixed.getBandwidthOfProfile(i), reference.getBandwidthOfProfile(i), round, "getBandwidthOfProfile", std::string(), i);
+    checker.expect(fixed.getUserDataOfProfile(i), reference.getUserDataOfProfile(i), round, "getUserDataOfProfile", std::string(), i);
+  }
+  for (int i = 0; i < 8; i++) {
+    int bandwidth = (int)(random.below(2) ? bandwidths[random.below(profiles)] : random.below(4000000));
+    checker.expect(fixed.getBestMatchedProfileIndexByBandWidth(bandwidth), reference.getBestMatchedProfileIndexByBandWidth(bandwidth),
+      round, "getBestMatchedProfileIndexByBandWidth", std::string(), bandwidth);
+  }
+
+  for (size_t p = 0; p < periodIds.size(); p++) {
+    const std::string& periodId = periodIds[p];
+    checker.expect(fixed.getMaxBandwidthProfile(periodId), reference.getMaxBandwidthProfile(periodId), round,
+      "getMaxBandwidthProfile", periodId, 0);
+    for (int i = 0; i <= count; i++) {
+      checker.expect(fixed.getRampedDownProfileIndex(i, periodId), reference.getRampedDownProfileIndex(i, periodId), round,
+        "getRampedDownProfileIndex", periodId, i);
+      checker.expect(fixed.getRampedUpProfileIndex(i, periodId), reference.getRampedUpProfileIndex(i, periodId), round,
+        "getRampedUpProfileIndex", periodId, i);
+      checker.expect(fixed.isProfileIndexBitrateLowest(i, periodId), reference.isProfileIndexBitrateLowest(i, periodId), round,
+        "isProfileIndexBitrateLowest", periodId, i);
+    }
+
+    // ABRManager needs a ladder for these
+    if (!hasLadder[p]) {
+      continue;
+    }
+    for (int medium = 0; medium < 2; medium++) {
+      checker.expect(fixed.getInitialProfileIndex(medium, periodId), reference.getInitialProfileIndex(medium, periodId), round,
+        "getInitialProfileIndex", periodId, medium);
+    }
+    int fixedProfile = fixed.getInitialProfileIndex(false, periodId);
+    int referenceProfile = reference.getInitialProfileIndex(false, periodId);
+    int nwConsistencyCnt = 1 + random.below(3);
+    for (int step = 0; step < RAMP_STEPS; step++) {
+      long networkBandwidth = random.below(8) ? random.below(4000000) : -1;
+      fixedProfile = fixed.getProfileIndexByBitrateRampUpOrDown(fixedProfile, fixed.getBandwidthOfProfile(fixedProfile),
+        networkBandwidth, nwConsistencyCnt, periodId);
+      referenceProfile = reference.getProfileIndexByBitrateRampUpOrDown(referenceProfile, reference.getBandwidthOfProfile(referenceProfile),
+        networkBandwidth, nwConsistencyCnt, periodId);
+      checker.expect(fixedProfile, referenceProfile, round, "getProfileIndexByBitrateRampUpOrDown", periodId, networkBandwidth);
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  int rounds = DEFAULT_ROUNDS;
+  unsigned long long seed = 1;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      rounds = atoi(argv[++i]);
+    } else if (arg == "-r" && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (arg == "-v") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "Usage: %s [-n rounds] [-r seed] [-v]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (rounds <= 0) {
+    fprintf(stderr, "Invalid rounds %d\n", rounds);
+    return 2;
+  }
+
+  std::string collidingFirst;
+  std::string collidingSecond;
+  if (!findCollision(collidingFirst, collidingSecond)) {
+    fprintf(stderr, "No period-Id hash collision found\n");
+    return 2;
+  }
+  // The colliding pair first, so that most rounds use both; the last one is never used
+  std::vector<std::string> periodIds;
+  periodIds.push_back(collidingFirst);
+  periodIds.push_back(collidingSecond);
+  periodIds.push_back(std::string());
+  periodIds.push_back("1");
+  periodIds.push_back("unused");
+
+  ABRManager::disableLogger();
+  Random random(seed);
+  Checker checker(verbose);
+  CheckedManager fixed;
+  ABRManager reference;
+  for (int round = 0; round < rounds; round++) {
+    runRound(fixed, reference, periodIds, random, round, checker);
+  }
+  printf("%d ladders, colliding period-Ids \"%s\" and \"%s\", %ld checks, %ld differences\n",
+    rounds, collidingFirst.c_str(), collidingSecond.c_str(), checker.checks, checker.differences);
+  return checker.differences ? 1 : 0;
+}
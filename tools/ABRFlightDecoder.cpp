@@ -0,0 +1,118 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRFlightDecoder.cpp
+ * @brief Prints a flight recorder dump as text, one record per line
+ *
+ * Usage: abr-flight-decode <dump file>
+ ***************************************************/
+
+#include "ABRFlightRecorder.h"
+#include <cstdio>
+#include <cinttypes>
+#include <vector>
+
+/**
+ * @brief Name and argument names of a record type
+ */
+struct RecordFormat {
+  const char* name;
+  const char* args[ABRFlightRecorder::MAX_RECORD_ARGS];
+};
+
+/**
+ * @brief Formats, indexed by ABRFlightRecorder::RecordType
+ */
+static const RecordFormat RECORD_FORMATS[ABRFlightRecorder::eRECORD_TYPE_MAX] = {
+  { "NONE", { 0 } },
+  { "THRESHOLD_SIZE", { "bufferlen", "downloadTimeMs", "currentProfilebps", "fragmentDurationMs", "abortReason", "downloadbps" } },
+  { "LL_CHUNK_SAMPLE", { "timeNow", "totalDlDiff", "timeDiff", "currentTotalDownloaded", "bitsPerSecond", 0 } },
+  { "CACHE_LENGTH", { "timeMs", "downloadbps", "lowLatency", "cacheSize", 0, 0 } },
+  { "CACHE_LIFE", { "presentTimeMs", "cacheSize", "samplesKept", 0, 0, 0 } },
+  { "CACHE_OUTLIER", { "samples", "outliers", "estimate", 0, 0, 0 } },
+  { "RAMP_UP_OR_DOWN", { "currProfile", "currBandwidth", "nwBandwidth", "nwConsistency", "periodHash", 0 } },
+  { "PROFILE_CHANGE_CHECK", { "fetchedDurationMs", "currProfile", "availBW", 0, 0, 0 } },
+  { "DESIRED_ON_BUFFER", { "currProfile", "newProfile", "bufferMs", "minBufferMs", "periodHash", 0 } },
+  { "RAMPUP_STEADY_STATE", { "currProfile", "newProfile", "nwBandwidth", "bufferMs", "newBandwidth", "maxBufferCountCheck" } },
+  { "RAMPDOWN_STEADY_STATE", { "currProfile", "newProfile", "lowBufferCounter", "periodHash", 0, 0 } },
+  { "INITIAL_PROFILE", { "chooseMedium", "periodHash", "defaultInitBitrate", "persistedBandwidth", 0, 0 } },
+  { "ADD_PROFILE", { "bandwidth", "isIframe", "width", "height", "periodHash", "userData" } },
+  { "CLEAR_PROFILES", { 0 } },
+  { "CONFIG", { "cacheLife", "cacheLength", "skipDuration", "nwConsistency", "thresholdSize", "maxBuffer<<32|minBuffer" } },
+  { "PROFILE_CHANGE", { "currProfile", "newProfile", 0, 0, 0, 0 } },
+  { "QUALITY", { "nwBandwidth", "qualityMilli", "scored", "periodHash", 0, 0 } },
+  { "DATA_SAVER_CAP", { "nwBandwidth", "cap", "sessionBytes", "windowBytes", 0, 0 } },
+  { "ABANDON_CHECK", { "bytesSoFar", "elapsedMs", "expectedBytes", "bufferMs", "currProfile", "periodHash" } },
+  { "FETCH_ADVICE", { "bufferMs", "fragmentDurationMs", "nwBandwidth", "profileBandwidth", "delayMs", "parallel" } },
+  { "STARTUP_PROFILE", { "estimate", "confidenceMilli", "defaultInitBitrate", "persistedBandwidth", "periodHash", 0 } },
+  { "STARTUP_PROBE", { "currProfile", "probeBandwidth", "fragmentNumber", "periodHash", 0, 0 } },
+  { "FAST_START", { "currProfile", "nwBandwidth", "bufferMs", "allowedBandwidth", "fragments", "periodHash" } },
+  { "LINK_THROUGHPUT", { "transferId", "bytes", "periodBytes", "activeTransfers", 0, 0 } },
+  { "TCP_INFO", { "rate", "rttUs", "minRttUs", "cwnd", "totalRetrans", "smoothedRate" } },
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <flight recorder dump>\n", argv[0]);
+    return 1;
+  }
+  FILE* f = fopen(argv[1], "rb");
+  if (!f) {
+    fprintf(stderr, "Failed to open %s\n", argv[1]);
+    return 1;
+  }
+  ABRFlightRecorder::DumpHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != ABRFlightRecorder::DUMP_MAGIC) {
+    fprintf(stderr, "%s is not a flight recorder dump\n", argv[1]);
+    fclose(f);
+    return 1;
+  }
+  if (header.version != ABRFlightRecorder::DUMP_VERSION || header.recordSize != sizeof(ABRFlightRecorder::Record)) {
+    fprintf(stderr, "Unsupported dump version %u record size %u\n", header.version, header.recordSize);
+    fclose(f);
+    return 1;
+  }
+
+  std::vector<ABRFlightRecorder::Record> records(header.recordCount);
+  if (header.recordCount && fread(&records[0], sizeof(ABRFlightRecorder::Record), records.size(), f) != records.size()) {
+    fprintf(stderr, "Truncated dump, expected %u records\n", header.recordCount);
+    fclose(f);
+    return 1;
+  }
+  fclose(f);
+
+  printf("# %u records\n", header.recordCount);
+  uint64_t start = records.empty() ? 0 : records[0].timestampNs;
+  for (size_t i = 0; i < records.size(); i++) {
+    const ABRFlightRecorder::Record& rec = records[i];
+    double relativeMs = (double)(int64_t)(rec.timestampNs - start) / 1e6;
+    if (rec.type >= ABRFlightRecorder::eRECORD_TYPE_MAX) {
+      printf("%12.3f UNKNOWN(%u)\n", relativeMs, rec.type);
+      continue;
+    }
+    const RecordFormat& format = RECORD_FORMATS[rec.type];
+    printf("%12.3f %-22s config=%u reason=%u result=%d", relativeMs, format.name, rec.configVersion, rec.reason, rec.result);
+    for (int arg = 0; arg < ABRFlightRecorder::MAX_RECORD_ARGS; arg++) {
+      if (format.args[arg]) {
+        printf(" %s=%" PRId64, format.args[arg], rec.args[arg]);
+      }
+    }
+    printf("\n");
+  }
+  return 0;
+}
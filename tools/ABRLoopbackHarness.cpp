@@ -0,0 +1,666 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRLoopbackHarness.cpp
+ * @brief End to end check of the bandwidth estimator on real transfers
+ *
+ * Usage: abr-loopback-harness [-s step|burst|ll] [-f schedule] [-c chunkMs] [-v]
+ *
+ * A segment server on 127.0.0.1 shapes every response to a programmable
+ * rate and latency schedule, optionally delivering each fragment as timed
+ * HTTP chunks like a low latency DASH live edge. A client downloads the
+ * fragments over TCP and feeds the HybridABRManager estimator
+ * (CheckAbrThresholdSize and the cache length/life/outlier updates, or
+ * CheckLLDashABRSpeedStoreSize per read in low latency mode) and ramp
+ * up/down decision, as a player does.
+ *
+ * Reported: estimate tracking error against the scheduled rate, and
+ * decision lag, the time from each rate change until the chosen profile is
+ * the highest one below the new rate.
+ *
+ * -s scenario: built in schedule, default step
+ * -f schedule: schedule file, lines "<time ms> <bps> [<latency ms>]", the
+ *              last line time is the run duration
+ * -c chunkMs:  deliver fragments as chunks of this duration (low latency)
+ * -v:          print every fragment
+ ***************************************************/
+
+#include "HybridABRManager.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Profile bitrates of the harness ladder
+ */
+static const long LADDER[] = { 500000, 1000000, 2000000, 3000000, 4500000, 6000000 };
+static const int LADDER_SIZE = sizeof(LADDER) / sizeof(LADDER[0]);
+
+/**
+ * @brief Estimator configuration, player defaults
+ */
+static const HybridABRManager::AampAbrConfig HARNESS_CONFIG = { 5000, 3, 6, 2, 6000, 10, 5, 5000000, false, false, false, false };
+
+static const long FRAGMENT_MS = 2000;
+static const long TARGET_BUFFER_MS = 8000;
+static const long LOW_LATENCY_TARGET_BUFFER_MS = 3000;
+static const int SEND_BLOCK_SIZE = 4096;
+static const int SOCKET_BUFFER_SIZE = 16384;
+static const std::string PERIOD_ID = "0";
+
+/**
+ * @brief Rate and latency from a point in time
+ */
+struct SchedulePoint {
+  long long timeMs;
+  long bandwidth;
+  long latencyMs;
+};
+
+/**
+ * @brief Piecewise constant network schedule, the last point ends the run
+ */
+struct Schedule {
+  std::vector<SchedulePoint> points;
+
+  int indexAt(long long timeMs) const {
+    int i = 0;
+    while (i + 1 < (int)points.size() && points[i + 1].timeMs <= timeMs) {
+      i++;
+    }
+    return i;
+  }
+  long bandwidthAt(long long timeMs) const { return points[indexAt(timeMs)].bandwidth; }
+  long latencyAt(long long timeMs) const { return points[indexAt(timeMs)].latencyMs; }
+  long long durationMs() const { return points.back().timeMs; }
+};
+
+static int quietLogger(const char* fmt, ...) {
+  (void)fmt;
+  return 0;
+}
+
+static std::chrono::steady_clock::time_point sEpoch;
+
+/**
+ * @brief Harness time in ms
+ */
+static long long nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - sEpoch).count();
+}
+
+/**
+ * @brief Harness time in us, for the server pacing
+ */
+static long long nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sEpoch).count();
+}
+
+static void sleepUntilUs(long long timeUs) {
+  long long waitUs = timeUs - nowUs();
+  if (waitUs > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+  }
+}
+
+static void addPoint(Schedule& schedule, long long timeMs, long bandwidth, long latencyMs) {
+  SchedulePoint point = { timeMs, bandwidth, latencyMs };
+  schedule.points.push_back(point);
+}
+
+/**
+ * @brief Built in schedules
+ */
+static bool builtinSchedule(const std::string& name, Schedule& schedule, long& chunkMs) {
+  if (name == "step") {
+    addPoint(schedule, 0, 5000000, 20);
+    addPoint(schedule, 20000, 1500000, 20);
+    addPoint(schedule, 40000, 5000000, 20);
+    addPoint(schedule, 60000, 5000000, 20);
+  } else if (name == "burst") {
+    for (int i = 0; i < 20; i++) {
+      addPoint(schedule, i * 3000, 12000000, 10);
+      addPoint(schedule, i * 3000 + 1000, 1200000, 60);
+    }
+    addPoint(schedule, 60000, 1200000, 60);
+  } else if (name == "ll") {
+    addPoint(schedule, 0, 4000000, 10);
+    addPoint(schedule, 20000, 1500000, 10);
+    addPoint(schedule, 40000, 4000000, 10);
+    addPoint(schedule, 60000, 4000000, 10);
+    if (chunkMs == 0) {
+      chunkMs = 500;
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool readSchedule(const char* path, Schedule& schedule) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    SchedulePoint point = { 0, 0, 0 };
+    if (fields >> point.timeMs >> point.bandwidth) {
+      fields >> point.latencyMs;
+      point.bandwidth = std::max(point.bandwidth, 1000L);
+      schedule.points.push_back(point);
+    }
+  }
+  if (schedule.points.size() < 2) {
+    fprintf(stderr, "%s: at least two points are needed\n", path);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @class SegmentServer
+ * @brief Loopback HTTP server of synthetic fragments shaped to a schedule
+ *
+ * GET /fragment?bytes=<n>&chunks=<k>&chunkMs=<d> answers n bytes after the
+ * scheduled latency. With k > 1 the body is sent with chunked encoding, and
+ * chunk i only becomes available i * d ms after the request, as at a live
+ * edge.
+ */
+class SegmentServer {
+public:
+  SegmentServer(const Schedule& schedule) : mSchedule(schedule), mListenFd(-1), mPort(0), mStop(false), mThread() {}
+
+  bool start() {
+    mListenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (mListenFd < 0) {
+      return false;
+    }
+    int one = 1;
+    setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(mListenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(mListenFd, 4) != 0
+      || getsockname(mListenFd, (struct sockaddr*)&addr, &len) != 0) {
+      close(mListenFd);
+      mListenFd = -1;
+      return false;
+    }
+    mPort = ntohs(addr.sin_port);
+    mThread = std::thread(&SegmentServer::serve, this);
+    return true;
+  }
+
+  void stop() {
+    mStop = true;
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+    if (mListenFd >= 0) {
+      close(mListenFd);
+      mListenFd = -1;
+    }
+  }
+
+  int port() const { return mPort; }
+
+private:
+  void serve() {
+    while (!mStop) {
+      struct pollfd pfd = { mListenFd, POLLIN, 0 };
+      if (poll(&pfd, 1, 100) <= 0) {
+        continue;
+      }
+      int fd = accept(mListenFd, NULL, NULL);
+      if (fd < 0) {
+        continue;
+      }
+      // small buffers so that the client sees the shaping, not the loopback speed
+      int size = SOCKET_BUFFER_SIZE;
+      setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      handle(fd);
+      close(fd);
+    }
+  }
+
+  void handle(int fd) {
+    long long requestUs = nowUs();
+    std::string request;
+    char buf[1024];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+      ssize_t n = recv(fd, buf, sizeof(buf), 0);
+      if (n <= 0) {
+        return;
+      }
+      request.append(buf, n);
+    }
+    long bytes = 0, chunks = 1, chunkMs = 0;
+    sscanf(request.c_str(), "GET /fragment?bytes=%ld&chunks=%ld&chunkMs=%ld", &bytes, &chunks, &chunkMs);
+    chunks = std::max(chunks, 1L);
+
+    sleepUntilUs(requestUs + mSchedule.latencyAt(requestUs / 1000) * 1000);
+    char header[256];
+    if (chunks > 1) {
+      snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n");
+    } else {
+      snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Length: %ld\r\nConnection: close\r\n\r\n", bytes);
+    }
+    if (!sendAll(fd, header, strlen(header))) {
+      return;
+    }
+    std::vector<char> block(SEND_BLOCK_SIZE, 'x');
+    long long nextSendUs = nowUs();
+    for (long c = 0; c < chunks && !mStop; c++) {
+      long chunkBytes = bytes / chunks + (c < bytes % chunks ? 1 : 0);
+      if (chunks > 1) {
+        sleepUntilUs(requestUs + c * chunkMs * 1000);
+        nextSendUs = std::max(nextSendUs, nowUs());
+        snprintf(header, sizeof(header), "%lx\r\n", chunkBytes);
+        if (!sendAll(fd, header, strlen(header))) {
+          return;
+        }
+      }
+      while (chunkBytes > 0) {
+        int n = (int)std::min(chunkBytes, (long)SEND_BLOCK_SIZE);
+        sleepUntilUs(nextSendUs);
+        if (!sendAll(fd, &block[0], n)) {
+          return;
+        }
+        chunkBytes -= n;
+        nextSendUs += (long long)n * 8 * 1000000 / mSchedule.bandwidthAt(nowMs());
+      }
+      if (chunks > 1 && !sendAll(fd, "\r\n", 2)) {
+        return;
+      }
+    }
+    if (chunks > 1) {
+      sendAll(fd, "0\r\n\r\n", 5);
+    }
+  }
+
+  static bool sendAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+      ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+      if (n <= 0) {
+        return false;
+      }
+      data += n;
+      len -= n;
+    }
+    return true;
+  }
+
+  const Schedule& mSchedule;
+  int mListenFd;
+  int mPort;
+  std::atomic<bool> mStop;
+  std::thread mThread;
+};
+
+/**
+ * @brief Body decoder for Content-Length and chunked responses, counts
+ * payload bytes only
+ */
+class BodyDecoder {
+public:
+  BodyDecoder() : mHeaderDone(false), mChunked(false), mChunkLeft(0), mState(SIZE), mLine(), mPayload(0), mDone(false) {}
+
+  /**
+   * @return payload bytes in data
+   */
+  long feed(const char* data, size_t len) {
+    long payload = 0;
+    size_t i = 0;
+    if (!mHeaderDone) {
+      for (; i < len && !mHeaderDone; i++) {
+        mLine.push_back(data[i]);
+        size_t end = mLine.find("\r\n\r\n");
+        if (end != std::string::npos) {
+          mHeaderDone = true;
+          mChunked = mLine.find("Transfer-Encoding: chunked") != std::string::npos;
+          mLine.clear();
+        }
+      }
+    }
+    for (; i < len && !mDone; i++) {
+      char ch = data[i];
+      if (!mChunked) {
+        payload += len - i;
+        break;
+      }
+      switch (mState) {
+        case SIZE:
+          if (ch == '\n') {
+            mChunkLeft = strtol(mLine.c_str(), NULL, 16);
+            mLine.clear();
+            mState = mChunkLeft > 0 ? DATA : TRAILER;
+            mDone = (mChunkLeft == 0);
+          } else if (ch != '\r') {
+            mLine.push_back(ch);
+          }
+          break;
+        case DATA: {
+          long n = std::min((long)(len - i), mChunkLeft);
+          payload += n;
+          mChunkLeft -= n;
+          i += n - 1;
+          if (mChunkLeft == 0) {
+            mState = DATA_END;
+          }
+          break;
+        }
+        case DATA_END:
+          if (ch == '\n') {
+            mState = SIZE;
+          }
+          break;
+        case TRAILER:
+          break;
+      }
+    }
+    mPayload += payload;
+    return payload;
+  }
+
+private:
+  enum State { SIZE, DATA, DATA_END, TRAILER };
+  bool mHeaderDone;
+  bool mChunked;
+  long mChunkLeft;
+  State mState;
+  std::string mLine;
+  long mPayload;
+  bool mDone;
+};
+
+/**
+ * @brief Accumulated tracking error and decision lag
+ */
+struct Report {
+  int estimates;
+  double absErrorSum;
+  double errorSum;
+  double maxAbsError;
+  std::vector<long long> lags;
+  int unsettled;
+  long long stallMs;
+  int switches;
+};
+
+/**
+ * @brief Highest ladder profile at or below a bandwidth, the lowest if none
+ */
+static int idealProfile(long bandwidth) {
+  int ideal = 0;
+  for (int i = 0; i < LADDER_SIZE; i++) {
+    if (LADDER[i] <= bandwidth) {
+      ideal = i;
+    }
+  }
+  return ideal;
+}
+
+/**
+ * @brief Fetch loop of the client
+ */
+static void runClient(int port, const Schedule& schedule, long chunkMs, bool verbose, Report& report) {
+  HybridABRManager abr;
+  HybridABRManager::AampAbrConfig config = HARNESS_CONFIG;
+  abr.ReadPlayerConfig(&config);
+  for (int i = 0; i < LADDER_SIZE; i++) {
+    abr.emplaceProfile(false, LADDER[i], 0, 0, PERIOD_ID, i);
+  }
+  const bool lowLatency = chunkMs > 0;
+  const long targetBufferMs = lowLatency ? LOW_LATENCY_TARGET_BUFFER_MS : TARGET_BUFFER_MS;
+  std::vector<std::pair<long long, long> > bitrateData;
+  std::vector<long> samples;
+  SpeedCache speedCache;
+  int currentProfile = abr.getInitialProfileIndex(false, PERIOD_ID);
+  long long bufferMs = 0;
+  long long playedUntil = -1;
+  long long fetchedMs = 0;
+  int scheduleIndex = 0;
+  long long changeTimeMs = -1;
+
+  while (nowMs() < schedule.durationMs()) {
+    // play out, wait while the buffer is full
+    long long now = nowMs();
+    if (playedUntil >= 0) {
+      bufferMs -= now - playedUntil;
+      if (bufferMs < 0) {
+        report.stallMs -= bufferMs;
+        abr.ReportStall(-bufferMs);
+        bufferMs = 0;
+      }
+      playedUntil = now;
+      if (bufferMs > targetBufferMs) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(bufferMs - targetBufferMs));
+        continue;
+      }
+    }
+
+    long currentBandwidth = abr.getBandwidthOfProfile(currentProfile);
+    long bytes = currentBandwidth / 8 * FRAGMENT_MS / 1000;
+    long chunks = lowLatency ? std::max(FRAGMENT_MS / chunkMs, 1L) : 1;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+      fprintf(stderr, "connect failed: %s\n", strerror(errno));
+      if (fd >= 0) {
+        close(fd);
+      }
+      return;
+    }
+    int size = SOCKET_BUFFER_SIZE;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    char request[128];
+    snprintf(request, sizeof(request), "GET /fragment?bytes=%ld&chunks=%ld&chunkMs=%ld HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n",
+      bytes, chunks, chunkMs);
+    long long startMs = nowMs();
+    send(fd, request, strlen(request), MSG_NOSIGNAL);
+
+    BodyDecoder body;
+    long received = 0;
+    char buf[16384];
+    speedCache.last_sample_time_val = startMs;
+    speedCache.prevSampleTotalDownloaded = 0;
+    for (;;) {
+      ssize_t n = recv(fd, buf, sizeof(buf), 0);
+      if (n <= 0) {
+        break;
+      }
+      received += body.feed(buf, n);
+      if (lowLatency) {
+        // progress callback sampling of a low latency player
+        long timeNow = (long)nowMs();
+        long timeDiff = timeNow - speedCache.last_sample_time_val;
+        long dlDiff = received - speedCache.prevSampleTotalDownloaded;
+        if (abr.IsABRDataGoodToEstimate(timeDiff) && dlDiff > 0) {
+          long bitsPerSecond = 0;
+          abr.CheckLLDashABRSpeedStoreSize(&speedCache, bitsPerSecond, timeNow, dlDiff, timeDiff, received);
+          if (bitsPerSecond > 0) {
+            abr.UpdateABRBitrateDataBasedOnCacheLength(bitrateData, bitsPerSecond, true);
+          }
+        }
+      }
+    }
+    close(fd);
+    long long endMs = nowMs();
+    long long downloadMs = std::max(endMs - startMs, 1LL);
+
+    if (playedUntil < 0) {
+      playedUntil = endMs;
+      abr.ReportStartup(endMs);
+    } else {
+      bufferMs -= endMs - playedUntil;
+      if (bufferMs < 0) {
+        report.stallMs -= bufferMs;
+        abr.ReportStall(-bufferMs);
+        bufferMs = 0;
+      }
+      playedUntil = endMs;
+    }
+    bufferMs += FRAGMENT_MS;
+    fetchedMs += FRAGMENT_MS;
+    abr.ReportFragment(currentProfile, FRAGMENT_MS);
+
+    if (!lowLatency && received > config.abrThresholdSize) {
+      long downloadbps = abr.CheckAbrThresholdSize((int)received, (int)downloadMs, currentBandwidth, FRAGMENT_MS,
+        HybridABRManager::eCURL_ABORT_REASON_NONE);
+      abr.UpdateABRBitrateDataBasedOnCacheLength(bitrateData, downloadbps, false);
+    }
+    samples.clear();
+    abr.UpdateABRBitrateDataBasedOnCacheLife(bitrateData, samples);
+    long estimate = samples.empty() ? -1 : abr.UpdateABRBitrateDataBasedOnCacheOutlier(samples);
+
+    long actual = schedule.bandwidthAt(endMs);
+    if (estimate > 0) {
+      double error = (double)(estimate - actual) / actual;
+      report.estimates++;
+      report.errorSum += error;
+      report.absErrorSum += std::fabs(error);
+      report.maxAbsError = std::max(report.maxAbsError, std::fabs(error));
+    }
+
+    int desiredProfile = currentProfile;
+    if (abr.CheckProfileChange(fetchedMs / 1000.0, currentProfile, estimate)) {
+      desiredProfile = abr.getProfileIndexByBitrateRampUpOrDown(currentProfile, currentBandwidth, estimate,
+        config.abrNwConsistency, PERIOD_ID);
+    }
+    if (desiredProfile != currentProfile) {
+      report.switches++;
+    }
+
+    // decision lag: from a rate change to the profile fitting the new rate
+    int index = schedule.indexAt(endMs);
+    if (index != scheduleIndex && schedule.points[index].bandwidth != schedule.points[scheduleIndex].bandwidth) {
+      if (changeTimeMs >= 0) {
+        report.unsettled++;
+      }
+      changeTimeMs = schedule.points[index].timeMs;
+    }
+    scheduleIndex = index;
+    if (changeTimeMs >= 0 && desiredProfile == idealProfile(actual)) {
+      report.lags.push_back(endMs - changeTimeMs);
+      changeTimeMs = -1;
+    }
+
+    if (verbose) {
+      printf("%7lld ms rate %8ld estimate %8ld profile %d -> %d buffer %5lld ms download %5lld ms\n",
+        endMs, actual, estimate, currentProfile, desiredProfile, bufferMs, downloadMs);
+    }
+    currentProfile = desiredProfile;
+  }
+  if (changeTimeMs >= 0) {
+    report.unsettled++;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string scenario = "step";
+  const char* scheduleFile = NULL;
+  long chunkMs = 0;
+  bool verbose = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "s:f:c:v")) != -1) {
+    switch (opt) {
+      case 's': scenario = optarg; break;
+      case 'f': scheduleFile = optarg; break;
+      case 'c': chunkMs = atol(optarg); break;
+      case 'v': verbose = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-s step|burst|ll] [-f schedule] [-c chunkMs] [-v]\n", argv[0]);
+        return 1;
+    }
+  }
+  Schedule schedule;
+  if (scheduleFile) {
+    if (!readSchedule(scheduleFile, schedule)) {
+      return 1;
+    }
+  } else if (!builtinSchedule(scenario, schedule, chunkMs)) {
+    fprintf(stderr, "Unknown scenario %s\n", scenario.c_str());
+    return 1;
+  }
+
+  ABRManager::disableLogger();
+  ABRManager::logprintf = quietLogger;
+  sEpoch = std::chrono::steady_clock::now();
+
+  SegmentServer server(schedule);
+  if (!server.start()) {
+    fprintf(stderr, "Failed to start the loopback server: %s\n", strerror(errno));
+    return 1;
+  }
+  Report report = Report();
+  runClient(server.port(), schedule, chunkMs, verbose, report);
+  server.stop();
+
+  printf("# %s, %lld ms, %s\n", scheduleFile ? scheduleFile : scenario.c_str(), schedule.durationMs(),
+    chunkMs > 0 ? "chunked low latency delivery" : "whole fragments");
+  if (report.estimates > 0) {
+    printf("estimates %d, mean error %+.1f%%, mean abs error %.1f%%, max abs error %.1f%%\n", report.estimates,
+      100 * report.errorSum / report.estimates, 100 * report.absErrorSum / report.estimates, 100 * report.maxAbsError);
+  } else {
+    printf("no estimate\n");
+  }
+  long long lagSum = 0;
+  printf("decision lags (ms):");
+  for (size_t i = 0; i < report.lags.size(); i++) {
+    printf(" %lld", report.lags[i]);
+    lagSum += report.lags[i];
+  }
+  printf("%s\n", report.lags.empty() ? " none" : "");
+  if (!report.lags.empty()) {
+    printf("mean decision lag %lld ms, rate changes not followed %d\n", lagSum / (long long)report.lags.size(), report.unsettled);
+  }
+  printf("switches %d, stall %lld ms\n", report.switches, report.stallMs);
+  return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRPoolBench.cpp
+ * @brief Sessions per core of ABRSessionPool
+ *
+ * Usage: abr-pool-bench [-s sessions] [-t threads] [-n rounds] [-f fragmentMs] [-m target]
+ *
+ * Each worker thread owns a shard of the given number of sessions, spread
+ * over a few shared ladders. A round feeds one download sample to every
+ * session and decides for all of them, once with decide() per session and
+ * once with decideAll(). The time per round gives the fragments handled
+ * per second per thread, and with one fragment every fragmentMs per session,
+ * the sessions a core sustains. Before that, released and out of range
+ * slots are checked to be refused and a reused slot to start clean. Exits 1
+ * if a check fails or a thread sustains fewer sessions than the target with
+ * either path.
+ *
+ * -s sessions:   sessions per thread, default 10000
+ * -t threads:    worker threads, one shard each, default 1
+ * -n rounds:     rounds of each path, default 200
+ * -f fragmentMs: fragment duration of a session, default 2000
+ * -m target:     sessions per core to reach, default 10000
+ ***************************************************/
+
+#include "ABRSessionPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int DEFAULT_SESSIONS = 10000;
+static const int DEFAULT_THREADS = 1;
+static const int DEFAULT_ROUNDS = 200;
+static const long long DEFAULT_FRAGMENT_MS = 2000;
+static const long DEFAULT_TARGET = 10000;
+
+/**
+ * @brief Shared ladders of the sessions
+ */
+static const long LADDERS[][6] = {
+  { 500000, 1000000, 2000000, 3000000, 4500000, 6000000 },
+  { 400000, 800000, 1600000, 2500000, 4000000, 8000000 },
+  { 300000, 700000, 1200000, 2200000, 3500000, 5000000 },
+  { 600000, 1100000, 1800000, 2800000, 4200000, 7000000 }
+};
+static const int LADDER_COUNT = sizeof(LADDERS) / sizeof(LADDERS[0]);
+static const int LADDER_SIZE = sizeof(LADDERS[0]) / sizeof(LADDERS[0][0]);
+
+/**
+ * @brief Pool configuration, player defaults
+ */
+static const ABRSessionPool::Config BENCH_CONFIG = { 5000, 3, 5000000, 2 };
+
+/**
+ * @brief Time per round of a thread, in seconds, for each path
+ */
+struct ThreadResult {
+  double decideSeconds;
+  double decideAllSeconds;
+
+  ThreadResult() : decideSeconds(0), decideAllSeconds(0) {}
+};
+
+/**
+ * @brief Download speed of a session at a round, swings across the ladder
+ */
+static long sampleAt(int session, int round) {
+  unsigned hash = (unsigned)session * 2654435761u + (unsigned)round * 40503u;
+  return 250000 + (long)(hash % 8000000);
+}
+
+/**
+ * @brief Calls on a released or out of range slot are refused, a reused slot
+ * has no samples of the released session
+ */
+static bool checkSlots(ABRSessionPool::Shard& shard, int ladderId) {
+  int slot = shard.createSession(ladderId, 2);
+  shard.addSample(slot, 8000000, 0);
+  shard.releaseSession(slot);
+  bool ok = shard.addSample(slot, 8000000, 0) == -1 && shard.decide(slot) == -1;
+  ok = ok && shard.addSample(-1, 8000000, 0) == -1 && shard.decide(-1) == -1;
+  ok = ok && shard.addSample(slot + 1000, 8000000, 0) == -1 && shard.decide(slot + 1000) == -1;
+  shard.releaseSession(slot);
+  int reused = shard.createSession(ladderId, 2);
+  // Only the new sample may count
+  ok = ok && reused == slot && shard.addSample(reused, 300000, 0) == 300000 && shard.decide(reused) >= 0;
+  shard.releaseSession(reused);
+  return ok;
+}
+
+static double runRounds(ABRSessionPool::Shard& shard, const std::vector<int>& slots, int rounds, int firstRound,
+  long long fragmentMs, bool batch) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int round = firstRound; round < firstRound + rounds; round++) {
+    long long nowMs = (long long)round * fragmentMs;
+    for (size_t i = 0; i < slots.size(); i++) {
+      shard.addSample(slots[i], sampleAt((int)i, round), nowMs);
+    }
+    if (batch) {
+      shard.decideAll();
+    } else {
+      for (size_t i = 0; i < slots.size(); i++) {
+        shard.decide(slots[i]);
+      }
+    }
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
+
+static void worker(ABRSessionPool& pool, int shardIndex, const std::vector<int>& ladderIds, int sessions, int rounds,
+  long long fragmentMs, ThreadResult& result) {
+  ABRSessionPool::Shard& shard = pool.getShard(shardIndex);
+  std::vector<int> slots;
+  slots.reserve(sessions);
+  for (int i = 0; i < sessions; i++) {
+    slots.push_back(shard.createSession(ladderIds[i % ladderIds.size()], 0));
+  }
+  // Warmup, fills the sample caches
+  runRounds(shard, slots, BENCH_CONFIG.cacheLength, 0, fragmentMs, false);
+  result.decideSeconds = runRounds(shard, slots, rounds, BENCH_CONFIG.cacheLength, fragmentMs, false);
+  result.decideAllSeconds = runRounds(shard, slots, rounds, BENCH_CONFIG.cacheLength + rounds, fragmentMs, true);
+}
+
+int main(int argc, char* argv[])
+{
+  int sessions = DEFAULT_SESSIONS;
+  int threads = DEFAULT_THREADS;
+  int rounds = DEFAULT_ROUNDS;
+  long long fragmentMs = DEFAULT_FRAGMENT_MS;
+  long target = DEFAULT_TARGET;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-s" && i + 1 < argc) {
+      sessions = atoi(argv[++i]);
+    } else if (arg == "-t" && i + 1 < argc) {
+      threads = atoi(argv[++i]);
+    } else if (arg == "-n" && i + 1 < argc) {
+      rounds = atoi(argv[++i]);
+    } else if (arg == "-f" && i + 1 < argc) {
+      fragmentMs = atoll(argv[++i]);
+    } else if (arg == "-m" && i + 1 < argc) {
+      target = atol(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [-s sessions] [-t threads] [-n rounds] [-f fragmentMs] [-m target]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (sessions <= 0 || threads <= 0 || rounds <= 0 || fragmentMs <= 0) {
+    fprintf(stderr, "Invalid sessions %d, threads %d, rounds %d or fragment duration %lld\n", sessions, threads, rounds, fragmentMs);
+    return 2;
+  }
+
+  ABRSessionPool pool(threads, BENCH_CONFIG);
+  std::vector<int> ladderIds;
+  for (int i = 0; i < LADDER_COUNT; i++) {
+    ladderIds.push_back(pool.addLadder(LADDERS[i], LADDER_SIZE));
+  }
+
+  if (!checkSlots(pool.getShard(0), ladderIds[0])) {
+    fprintf(stderr, "Released or out of range slot not refused, or reused slot not clean\n");
+    return 1;
+  }
+
+  std::vector<ThreadResult> results(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.push_back(std::thread(worker, std::ref(pool), t, std::cref(ladderIds), sessions, rounds, fragmentMs,
+      std::ref(results[t])));
+  }
+  for (size_t t = 0; t < workers.size(); t++) {
+    workers[t].join();
+  }
+
+  // The slowest thread sets the sessions per core
+  double decideSeconds = 0;
+  double decideAllSeconds = 0;
+  for (int t = 0; t < threads; t++) {
+    decideSeconds = std::max(decideSeconds, results[t].decideSeconds);
+    decideAllSeconds = std::max(decideAllSeconds, results[t].decideAllSeconds);
+  }
+  double decideFragments = sessions / decideSeconds;
+  double decideAllFragments = sessions / decideAllSeconds;
+  long decideSessions = (long)(decideFragments * fragmentMs / 1000);
+  long decideAllSessions = (long)(decideAllFragments * fragmentMs / 1000);
+  printf("%d threads, %d sessions per thread, %lld ms fragments\n", threads, sessions, fragmentMs);
+  printf("decide:    %12.0f fragments/s per thread, %10ld sessions per core\n", decideFragments, decideSessions);
+  printf("decideAll: %12.0f fragments/s per thread, %10ld sessions per core\n", decideAllFragments, decideAllSessions);
+  return (decideSessions < target || decideAllSessions < target) ? 1 : 0;
+}
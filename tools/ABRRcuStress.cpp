@@ -0,0 +1,166 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRRcuStress.cpp
+ * @brief Stress of ABRRcuValue with back to back publishes and concurrent readers
+ *
+ * Usage: abr-rcu-stress [-p publishes] [-r readers] [-v]
+ *
+ * A writer publishes values back to back, as successive configuration
+ * pushes do, while reader threads pin snapshots and hold them for a short
+ * random time. A snapshot freed under a reader is poisoned by its
+ * destructor, or reused by a later snapshot of another version: each reader
+ * checks its snapshot is unchanged and consistent before releasing it.
+ * Versions seen by a reader must never go back. Exits 1 on any violation.
+ *
+ * -p publishes: number of publishes, default 200000
+ * -r readers:   number of reader threads, default 4
+ * -v:           print the reads of each reader
+ ***************************************************/
+
+#include "ABRRcuValue.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const unsigned VALUE_ALIVE = 0x414c4956;
+static const unsigned VALUE_DEAD = 0x44454144;
+static const int DEFAULT_PUBLISHES = 200000;
+static const int DEFAULT_READERS = 4;
+static const int MAX_HOLD_SPINS = 256;
+
+/**
+ * @brief Published value, every field derives from seq
+ */
+struct StressValue {
+  unsigned canary;
+  unsigned long long seq;
+  unsigned long long check;
+
+  StressValue() : canary(VALUE_ALIVE), seq(0), check(~0ULL) {}
+  explicit StressValue(unsigned long long s) : canary(VALUE_ALIVE), seq(s), check(~s) {}
+  ~StressValue() { canary = VALUE_DEAD; }
+
+  bool consistent() const { return canary == VALUE_ALIVE && check == ~seq; }
+};
+
+/**
+ * @brief Counters of a reader thread
+ */
+struct ReaderResult {
+  unsigned long long reads;
+  unsigned long long violations;
+  unsigned long long versions;
+
+  ReaderResult() : reads(0), violations(0), versions(0) {}
+};
+
+static void readLoop(const ABRRcuValue<StressValue>& holder, const std::atomic<bool>& done, unsigned seed,
+  ReaderResult& result) {
+  unsigned lastVersion = 0;
+  volatile unsigned sink = 0;
+  while (!done.load(std::memory_order_relaxed)) {
+    ABRRcuValue<StressValue>::Reader reader(holder);
+    unsigned version = reader.version();
+    unsigned long long seq = reader->seq;
+    bool ok = reader->consistent() && seq + 1 == version && version >= lastVersion;
+
+    // Hold the snapshot while the writer goes on publishing
+    seed = seed * 1103515245 + 12345;
+    int spins = (seed >> 16) % MAX_HOLD_SPINS;
+    for (int i = 0; i < spins; i++) {
+      sink += i;
+    }
+    if (spins & 1) {
+      std::this_thread::yield();
+    }
+    ok = ok && reader->consistent() && reader->seq == seq && reader.version() == version;
+
+    if (!ok) {
+      result.violations++;
+    }
+    if (version != lastVersion) {
+      result.versions++;
+    }
+    lastVersion = version;
+    result.reads++;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  int publishes = DEFAULT_PUBLISHES;
+  int readers = DEFAULT_READERS;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-p" && i + 1 < argc) {
+      publishes = atoi(argv[++i]);
+    } else if (arg == "-r" && i + 1 < argc) {
+      readers = atoi(argv[++i]);
+    } else if (arg == "-v") {
+      verbose = true;
+    } else {
+      fprintf(stderr, "Usage: %s [-p publishes] [-r readers] [-v]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (publishes <= 0 || readers <= 0) {
+    fprintf(stderr, "Invalid publishes %d or readers %d\n", publishes, readers);
+    return 2;
+  }
+
+  ABRRcuValue<StressValue> holder(StressValue(0));
+  std::atomic<bool> done(false);
+  std::vector<ReaderResult> results(readers);
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; r++) {
+    threads.push_back(std::thread(readLoop, std::cref(holder), std::cref(done), (unsigned)(r + 1), std::ref(results[r])));
+  }
+
+  unsigned long long publishViolations = 0;
+  for (int p = 1; p <= publishes; p++) {
+    unsigned version = holder.publish(StressValue((unsigned long long)p));
+    if (version != (unsigned)p + 1) {
+      publishViolations++;
+    }
+    // Let the readers run between the publishes, even on a single core
+    if (p % 2 == 0) {
+      std::this_thread::yield();
+    }
+  }
+  done.store(true);
+  for (size_t t = 0; t < threads.size(); t++) {
+    threads[t].join();
+  }
+
+  unsigned long long reads = 0;
+  unsigned long long violations = publishViolations;
+  for (int r = 0; r < readers; r++) {
+    reads += results[r].reads;
+    violations += results[r].violations;
+    if (verbose) {
+      printf("reader %d: %llu reads, %llu versions, %llu violations\n", r, results[r].reads, results[r].versions,
+        results[r].violations);
+    }
+  }
+  printf("%d publishes, %d readers, %llu reads, %llu violations\n", publishes, readers, reads, violations);
+  return violations ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRSharedCheck.cpp
+ * @brief Check that ABRSharedBandwidth recovers from a publisher killed
+ * during an update
+ *
+ * Usage: abr-shared-check [-n attempts] [-r readers] [-p path]
+ *
+ * Each attempt forks a writer process publishing back to back, and SIGKILLs
+ * it after a random delay, which often leaves the lock held by the dead
+ * process and the update torn (reads fail). Reader processes are then
+ * forked, reading until they see the sample of a new writer process, which
+ * must take the lock over and publish at once. Any read of a value no
+ * writer published, a failed takeover, or a reader not recovering within
+ * a few seconds fails the check, as does no attempt catching a torn update.
+ * Exits 1 on failure.
+ *
+ * -n attempts: writers killed, default 200
+ * -r readers:  reader processes per attempt, default 2
+ * -p path:     segment, default /dev/shm/abr-shared-check-<pid>, removed at the end
+ ***************************************************/
+
+#include "ABRSharedBandwidth.h"
+#include "ABRManager.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+static const int DEFAULT_ATTEMPTS = 200;
+static const int DEFAULT_READERS = 2;
+static const long long RECOVERY_TIMEOUT_MS = 5000;
+static const int MAX_KILL_DELAY_US = 500;
+
+/**
+ * @brief Samples of the killed writers, bandwidth and time by attempt
+ */
+static const long WRITER_BANDWIDTH = 1000000;
+static const long WRITER_BANDWIDTH_RANGE = 1000;
+static const long long ATTEMPT_TIME_MS = 1000000000LL;
+
+/**
+ * @brief Sample of the writer taking the lock over
+ */
+static const long TAKEOVER_BANDWIDTH = 50000000;
+
+static long long monotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static long takeoverBandwidth(int attempt) {
+  return TAKEOVER_BANDWIDTH + attempt;
+}
+
+/**
+ * @brief A read value must come from one writer of the attempt
+ */
+static bool isPublished(long bandwidth, int attempt) {
+  return (bandwidth >= WRITER_BANDWIDTH && bandwidth < WRITER_BANDWIDTH + WRITER_BANDWIDTH_RANGE) ||
+    bandwidth == takeoverBandwidth(attempt) || (attempt > 0 && bandwidth == takeoverBandwidth(attempt - 1));
+}
+
+/**
+ * @brief Writer process, publishes until killed
+ */
+static void runWriter(const std::string& path, int attempt) {
+  ABRSharedBandwidth shared;
+  if (!shared.open(path)) {
+    _exit(1);
+  }
+  for (long long i = 0; ; i++) {
+    shared.publish(WRITER_BANDWIDTH + (long)(i % WRITER_BANDWIDTH_RANGE), attempt * ATTEMPT_TIME_MS + i);
+  }
+}
+
+/**
+ * @brief Reader process, reads until the sample of the new writer shows up
+ */
+static void runReader(const std::string& path, int attempt) {
+  ABRSharedBandwidth shared;
+  if (!shared.open(path)) {
+    _exit(1);
+  }
+  long long deadline = monotonicMs() + RECOVERY_TIMEOUT_MS;
+  while (monotonicMs() < deadline) {
+    ABRSharedBandwidth::Estimate estimate;
+    if (shared.read(estimate)) {
+      if (!isPublished(estimate.bandwidth, attempt)) {
+        _exit(1);
+      }
+      if (estimate.bandwidth == takeoverBandwidth(attempt)) {
+        _exit(0);
+      }
+    }
+    usleep(100);
+  }
+  _exit(1);
+}
+
+/**
+ * @brief New writer process, must take the lock over from the dead one
+ */
+static void runTakeover(const std::string& path, int attempt) {
+  ABRSharedBandwidth shared;
+  if (!shared.open(path)) {
+    _exit(1);
+  }
+  _exit(shared.publish(takeoverBandwidth(attempt), (attempt + 1) * ATTEMPT_TIME_MS - 1) ? 0 : 1);
+}
+
+static pid_t spawn(void (*run)(const std::string&, int), const std::string& path, int attempt) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    run(path, attempt);
+  }
+  return pid;
+}
+
+static bool exitedOk(pid_t pid) {
+  int status = 0;
+  return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief One writer killed and replaced
+ *
+ * @param[out] torn true if reads failed after the kill
+ * @return true if the new writer took over and every reader recovered
+ */
+static bool runAttempt(ABRSharedBandwidth& shared, const std::string& path, int attempt, int readers, bool& torn) {
+  pid_t writer = spawn(runWriter, path, attempt);
+  if (writer < 0) {
+    return false;
+  }
+  // Kill once the writer is publishing
+  long long deadline = monotonicMs() + RECOVERY_TIMEOUT_MS;
+  ABRSharedBandwidth::Estimate estimate;
+  while (!(shared.read(estimate) && estimate.publisherPid == writer) && monotonicMs() < deadline) {
+    usleep(50);
+  }
+  usleep(rand() % MAX_KILL_DELAY_US);
+  kill(writer, SIGKILL);
+  waitpid(writer, NULL, 0);
+  torn = !shared.read(estimate);
+
+  std::vector<pid_t> readerPids;
+  for (int i = 0; i < readers; i++) {
+    readerPids.push_back(spawn(runReader, path, attempt));
+  }
+  pid_t takeover = spawn(runTakeover, path, attempt);
+  bool ok = exitedOk(takeover);
+  for (size_t i = 0; i < readerPids.size(); i++) {
+    ok = exitedOk(readerPids[i]) && ok;
+  }
+
+  ABRSharedBandwidth::Sample last;
+  ABRSharedBandwidth::Sample history[ABRSharedBandwidth::HISTORY_SIZE];
+  int count = shared.readHistory(history, ABRSharedBandwidth::HISTORY_SIZE);
+  last = count > 0 ? history[count - 1] : ABRSharedBandwidth::Sample();
+  return ok && shared.read(estimate) && estimate.bandwidth == takeoverBandwidth(attempt) &&
+    estimate.publisherPid == takeover && last.bandwidth == takeoverBandwidth(attempt);
+}
+
+int main(int argc, char* argv[])
+{
+  int attempts = DEFAULT_ATTEMPTS;
+  int readers = DEFAULT_READERS;
+  std::string path = "/dev/shm/abr-shared-check-" + std::to_string((long long)getpid());
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      attempts = atoi(argv[++i]);
+    } else if (arg == "-r" && i + 1 < argc) {
+      readers = atoi(argv[++i]);
+    } else if (arg == "-p" && i + 1 < argc) {
+      path = argv[++i];
+    } else {
+      fprintf(stderr, "Usage: %s [-n attempts] [-r readers] [-p path]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (attempts <= 0 || readers < 0) {
+    fprintf(stderr, "Invalid attempts %d or readers %d\n", attempts, readers);
+    return 2;
+  }
+
+  ABRManager::disableLogger();
+  ABRSharedBandwidth shared;
+  unlink(path.c_str());
+  if (!shared.open(path)) {
+    fprintf(stderr, "Failed to open %s\n", path.c_str());
+    return 2;
+  }
+  srand((unsigned)getpid());
+  int tornCount = 0;
+  int failed = 0;
+  for (int attempt = 0; attempt < attempts; attempt++) {
+    bool torn = false;
+    if (!runAttempt(shared, path, attempt, readers, torn)) {
+      fprintf(stderr, "attempt %d: no takeover or a reader did not recover%s\n", attempt, torn ? " (torn update)" : "");
+      failed++;
+    }
+    tornCount += torn;
+  }
+  shared.close();
+  unlink(path.c_str());
+
+  printf("%d writers killed, %d torn updates, %d failed recoveries\n", attempts, tornCount, failed);
+  if (tornCount == 0) {
+    fprintf(stderr, "No writer was killed during an update, raise -n\n");
+    return 1;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,628 @@
+/*
+ *   Copyright 2026 RDK Management
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/***************************************************
+ * @file ABRTuner.cpp
+ * @brief Sweeps AampAbrConfig values over recorded network traces
+ *
+ * Usage: abr-tuner [-j threads] [-r count] [-s seed] [-a] <spec> <trace>...
+ *
+ * Every configuration of the spec is run against every trace with the
+ * HybridABRManager logic on a simulated player, using a virtual clock, and
+ * the Pareto front of the configurations over QoE, average bitrate and
+ * rebuffer ratio (mean over the traces) is printed.
+ *
+ * Spec file, one knob per line, knobs not listed keep the default value:
+ *   <knob> <v1>,<v2>,...   values of a grid, or picked at random with -r
+ *   <knob> <min>:<max>     range, only with -r
+ * Knobs: abrCacheLife, abrCacheLength, abrSkipDuration, abrNwConsistency,
+ * abrThresholdSize, abrMaxBuffer, abrMinBuffer, abrCacheOutlier.
+ *
+ * Trace file:
+ *   ladder <bps> <bps>...   profile bitrates, required
+ *   fragment <ms>           fragment duration, default 2000
+ *   content <ms>            content duration, default 300000
+ *   <time ms> <bps> [<latency ms>]
+ *                           network throughput from this time on, and
+ *                           request latency (default 0)
+ * Lines starting with # are ignored.
+ *
+ * -j threads: worker threads, default all cores
+ * -r count:   random search with count draws (duplicates dropped) instead of the grid
+ * -s seed:    random search seed, default 1
+ * -a:         print every configuration, not only the Pareto front
+ ***************************************************/
+
+#include "HybridABRManager.h"
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef HybridABRManager::AampAbrConfig AampAbrConfig;
+
+/**
+ * @brief Tunable knob of AampAbrConfig
+ */
+struct Knob {
+  const char* name;
+  int AampAbrConfig::*field;
+};
+
+static const Knob KNOBS[] = {
+  { "abrCacheLife", &AampAbrConfig::abrCacheLife },
+  { "abrCacheLength", &AampAbrConfig::abrCacheLength },
+  { "abrSkipDuration", &AampAbrConfig::abrSkipDuration },
+  { "abrNwConsistency", &AampAbrConfig::abrNwConsistency },
+  { "abrThresholdSize", &AampAbrConfig::abrThresholdSize },
+  { "abrMaxBuffer", &AampAbrConfig::abrMaxBuffer },
+  { "abrMinBuffer", &AampAbrConfig::abrMinBuffer },
+  { "abrCacheOutlier", &AampAbrConfig::abrCacheOutlier },
+};
+static const int KNOB_COUNT = sizeof(KNOBS) / sizeof(KNOBS[0]);
+
+/**
+ * @brief Player defaults: cache life and outlier in ms and bps, skip
+ * duration and buffers in seconds, threshold in bytes
+ */
+static const AampAbrConfig DEFAULT_CONFIG = { 5000, 3, 6, 2, 6000, 10, 5, 5000000, false, false, false, false };
+
+/**
+ * @brief Player buffer limit, raised to fit abrMaxBuffer if needed
+ */
+static const long PLAYER_BUFFER_MS = 30000;
+
+/**
+ * @brief Lowest throughput of the network model, avoids endless downloads
+ */
+static const long MIN_TRACE_BANDWIDTH = 1000;
+
+/**
+ * @brief Period-Id of the simulated profiles
+ */
+static const std::string SIM_PERIOD_ID = "0";
+
+/**
+ * @brief Values of a knob in the spec
+ */
+struct KnobSpec {
+  int knob;
+  std::vector<int> values;
+  bool isRange;
+  int minValue;
+  int maxValue;
+};
+
+/**
+ * @brief Throughput from a point in time of a trace
+ */
+struct TracePoint {
+  long long timeMs;
+  long bandwidth;
+  long latencyMs;
+};
+
+/**
+ * @brief Recorded session network conditions
+ */
+struct Trace {
+  std::string name;
+  std::vector<long> ladder;
+  long fragmentMs;
+  long contentMs;
+  std::vector<TracePoint> points;
+};
+
+/**
+ * @brief Outcome of one configuration, on one trace or averaged
+ */
+struct Result {
+  double qoe;
+  double bitrate;
+  double rebufferRatio;
+  double switches;
+};
+
+static int quietLogger(const char* fmt, ...) {
+  (void)fmt;
+  return 0;
+}
+
+/**
+ * @brief Virtual clock of a simulated session
+ */
+static long long simulatedClock(void* context) {
+  return *static_cast<long long*>(context);
+}
+
+static bool findKnob(const std::string& name, int& knob) {
+  for (int i = 0; i < KNOB_COUNT; i++) {
+    if (name == KNOBS[i].name) {
+      knob = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool readSpec(const char* path, std::vector<KnobSpec>& specs) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string name, values;
+    if (!(fields >> name >> values)) {
+      continue;
+    }
+    KnobSpec spec;
+    spec.isRange = false;
+    spec.minValue = spec.maxValue = 0;
+    if (!findKnob(name, spec.knob)) {
+      fprintf(stderr, "Unknown knob %s\n", name.c_str());
+      return false;
+    }
+    if (values.find(':') != std::string::npos) {
+      spec.isRange = (sscanf(values.c_str(), "%d:%d", &spec.minValue, &spec.maxValue) == 2) && spec.minValue <= spec.maxValue;
+      if (!spec.isRange) {
+        fprintf(stderr, "Invalid range %s\n", values.c_str());
+        return false;
+      }
+    } else {
+      std::istringstream list(values);
+      std::string value;
+      while (std::getline(list, value, ',')) {
+        spec.values.push_back(atoi(value.c_str()));
+      }
+      if (spec.values.empty()) {
+        fprintf(stderr, "No value for %s\n", name.c_str());
+        return false;
+      }
+    }
+    specs.push_back(spec);
+  }
+  return true;
+}
+
+static bool readTrace(const char* path, Trace& trace) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+  trace.name = path;
+  trace.fragmentMs = 2000;
+  trace.contentMs = 300000;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string key;
+    fields >> key;
+    if (key == "ladder") {
+      long bandwidth;
+      while (fields >> bandwidth) {
+        trace.ladder.push_back(bandwidth);
+      }
+    } else if (key == "fragment") {
+      fields >> trace.fragmentMs;
+    } else if (key == "content") {
+      fields >> trace.contentMs;
+    } else {
+      TracePoint point;
+      point.timeMs = atoll(key.c_str());
+      point.bandwidth = 0;
+      point.latencyMs = 0;
+      fields >> point.bandwidth >> point.latencyMs;
+      point.bandwidth = std::max(point.bandwidth, MIN_TRACE_BANDWIDTH);
+      trace.points.push_back(point);
+    }
+  }
+  if (trace.ladder.empty() || trace.points.empty() || trace.fragmentMs <= 0) {
+    fprintf(stderr, "%s: ladder and throughput are required\n", path);
+    return false;
+  }
+  std::sort(trace.ladder.begin(), trace.ladder.end());
+  return true;
+}
+
+/**
+ * @brief Time to download bytes from startMs, following the trace throughput
+ */
+static long long downloadTimeMs(const Trace& trace, long long startMs, long long bytes) {
+  size_t i = 0;
+  while (i + 1 < trace.points.size() && trace.points[i + 1].timeMs <= startMs) {
+    i++;
+  }
+  long long now = startMs + trace.points[i].latencyMs;
+  double bits = bytes * 8.0;
+  while (bits > 0) {
+    while (i + 1 < trace.points.size() && trace.points[i + 1].timeMs <= now) {
+      i++;
+    }
+    double bps = trace.points[i].bandwidth;
+    long long segmentEnd = (i + 1 < trace.points.size()) ? trace.points[i + 1].timeMs : -1;
+    double needMs = bits * 1000.0 / bps;
+    if (segmentEnd < 0 || now + needMs <= segmentEnd) {
+      now += (long long)(needMs + 0.5);
+      bits = 0;
+    } else {
+      bits -= (segmentEnd - now) * bps / 1000.0;
+      now = segmentEnd;
+    }
+  }
+  return std::max(now - startMs, 1LL);
+}
+
+/**
+ * @brief Play a trace with the HybridABRManager logic, on the fragment fetch
+ * loop of a player: bandwidth sample per fragment, ramp up/down decision,
+ * buffer based checks and steady state ramp up/down.
+ */
+static Result simulate(const Trace& trace, const AampAbrConfig& config) {
+  long long now = 1000;
+  HybridABRManager abr;
+  AampAbrConfig playerConfig = config;
+  abr.setClock(simulatedClock, &now);
+  abr.ReadPlayerConfig(&playerConfig);
+  for (size_t i = 0; i < trace.ladder.size(); i++) {
+    abr.emplaceProfile(false, trace.ladder[i], 0, 0, SIM_PERIOD_ID, (int)i);
+  }
+
+  const long fragmentMs = trace.fragmentMs;
+  const long bufferLimitMs = std::max(PLAYER_BUFFER_MS, config.abrMaxBuffer * 1000L + 2 * fragmentMs);
+  std::vector<std::pair<long long, long> > bitrateData;
+  std::vector<long> samples;
+  int currentProfile = abr.getInitialProfileIndex(false, SIM_PERIOD_ID);
+  long long startMs = now;
+  long long bufferMs = 0;
+  long long fetchedMs = 0;
+  long long stallMs = 0;
+  double bitrateTime = 0;
+  int switches = 0;
+  bool playing = false;
+  int highBufferCounter = 0;
+  int lowBufferCounter = 0;
+  int maxBufferCountCheck = config.abrCacheLength;
+
+  while (fetchedMs < trace.contentMs) {
+    if (playing && bufferMs + fragmentMs > bufferLimitMs) {
+      long long waitMs = bufferMs + fragmentMs - bufferLimitMs;
+      now += waitMs;
+      bufferMs -= waitMs;
+    }
+    long currentBandwidth = abr.getBandwidthOfProfile(currentProfile);
+    long long bytes = (long long)currentBandwidth * fragmentMs / 8000;
+    long long downloadMs = downloadTimeMs(trace, now, bytes);
+    if (playing) {
+      if (downloadMs > bufferMs) {
+        stallMs += downloadMs - bufferMs;
+        abr.ReportStall(downloadMs - bufferMs);
+        bufferMs = 0;
+      } else {
+        bufferMs -= downloadMs;
+      }
+    }
+    now += downloadMs;
+    bufferMs += fragmentMs;
+    fetchedMs += fragmentMs;
+    bitrateTime += (double)currentBandwidth * fragmentMs;
+    abr.ReportFragment(currentProfile, fragmentMs);
+    if (!playing) {
+      playing = true;
+      abr.ReportStartup(now - startMs);
+    }
+
+    if (bytes > config.abrThresholdSize) {
+      long downloadbps = abr.CheckAbrThresholdSize((int)std::min(bytes, (long long)INT32_MAX), (int)downloadMs,
+        currentBandwidth, fragmentMs, HybridABRManager::eCURL_ABORT_REASON_NONE);
+      abr.UpdateABRBitrateDataBasedOnCacheLength(bitrateData, downloadbps, false);
+    }
+    samples.clear();
+    abr.UpdateABRBitrateDataBasedOnCacheLife(bitrateData, samples);
+    long networkBandwidth = samples.empty() ? -1 : abr.UpdateABRBitrateDataBasedOnCacheOutlier(samples);
+
+    int desiredProfile = currentProfile;
+    HybridABRManager::BitrateChangeReason reason = HybridABRManager::eAAMP_BITRATE_CHANGE_BY_ABR;
+    if (abr.CheckProfileChange(fetchedMs / 1000.0, currentProfile, networkBandwidth)) {
+      desiredProfile = abr.getProfileIndexByBitrateRampUpOrDown(currentProfile, currentBandwidth,
+        networkBandwidth, config.abrNwConsistency, SIM_PERIOD_ID);
+    }
+    double bufferValue = bufferMs / 1000.0;
+    if (desiredProfile != currentProfile) {
+      abr.GetDesiredProfileOnBuffer(currentProfile, desiredProfile, bufferValue, config.abrMinBuffer, SIM_PERIOD_ID);
+    } else if (networkBandwidth > 0) {
+      if (bufferValue >= config.abrMaxBuffer) {
+        if (++highBufferCounter > maxBufferCountCheck) {
+          int rampedUp = abr.getRampedUpProfileIndex(currentProfile, SIM_PERIOD_ID);
+          abr.CheckRampupFromSteadyState(currentProfile, desiredProfile, networkBandwidth, bufferValue,
+            abr.getBandwidthOfProfile(rampedUp), reason, maxBufferCountCheck, SIM_PERIOD_ID);
+          highBufferCounter = 0;
+        }
+      } else {
+        highBufferCounter = 0;
+      }
+      if (bufferValue < config.abrMinBuffer) {
+        lowBufferCounter++;
+        abr.CheckRampdownFromSteadyState(currentProfile, desiredProfile, reason, lowBufferCounter, SIM_PERIOD_ID);
+        if (desiredProfile != currentProfile) {
+          lowBufferCounter = 0;
+        }
+      } else {
+        lowBufferCounter = 0;
+      }
+    }
+    if (desiredProfile != currentProfile) {
+      switches++;
+      currentProfile = desiredProfile;
+    }
+  }
+
+  ABRQoEScore::Score score;
+  abr.GetSessionQoE(score);
+  Result result;
+  result.qoe = score.contentDuration > 0 ? score.total / score.contentDuration : 0;
+  result.bitrate = fetchedMs > 0 ? bitrateTime / fetchedMs : 0;
+  result.rebufferRatio = (double)stallMs / (fetchedMs + stallMs);
+  result.switches = switches;
+  return result;
+}
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs jobs 0..count-1 on worker threads. Each worker takes jobs from
+ * the back of its own queue and steals from the front of the others.
+ */
+class WorkStealingPool {
+public:
+  template <typename Job>
+  static void run(int jobCount, int threadCount, Job& job) {
+    std::vector<Queue> queues(threadCount);
+    // contiguous blocks, so that a worker with long jobs gets stolen from
+    for (int i = 0; i < jobCount; i++) {
+      queues[(long long)i * threadCount / jobCount].jobs.push_back(i);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+      threads.push_back(std::thread(worker<Job>, t, &queues, &job));
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+      threads[t].join();
+    }
+  }
+
+private:
+  struct Queue {
+    std::mutex lock;
+    std::deque<int> jobs;
+  };
+
+  template <typename Job>
+  static void worker(int self, std::vector<Queue>* queues, Job* job) {
+    int queueCount = static_cast<int>(queues->size());
+    for (;;) {
+      int next = -1;
+      {
+        Queue& own = (*queues)[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.jobs.empty()) {
+          next = own.jobs.back();
+          own.jobs.pop_back();
+        }
+      }
+      for (int k = 1; next < 0 && k < queueCount; k++) {
+        Queue& victim = (*queues)[(self + k) % queueCount];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.jobs.empty()) {
+          next = victim.jobs.front();
+          victim.jobs.pop_front();
+        }
+      }
+      // jobs do not add jobs, nothing left anywhere means done
+      if (next < 0) {
+        return;
+      }
+      (*job)(next);
+    }
+  }
+};
+
+/**
+ * @brief Run of one configuration on one trace
+ */
+struct SweepJob {
+  const std::vector<AampAbrConfig>* configs;
+  const std::vector<Trace>* traces;
+  std::vector<Result>* results;
+
+  void operator()(int index) {
+    int traceCount = static_cast<int>(traces->size());
+    (*results)[index] = simulate((*traces)[index % traceCount], (*configs)[index / traceCount]);
+  }
+};
+
+static void buildGrid(const std::vector<KnobSpec>& specs, std::vector<AampAbrConfig>& configs) {
+  configs.assign(1, DEFAULT_CONFIG);
+  for (size_t s = 0; s < specs.size(); s++) {
+    std::vector<AampAbrConfig> expanded;
+    for (size_t c = 0; c < configs.size(); c++) {
+      for (size_t v = 0; v < specs[s].values.size(); v++) {
+        AampAbrConfig config = configs[c];
+        config.*(KNOBS[specs[s].knob].field) = specs[s].values[v];
+        expanded.push_back(config);
+      }
+    }
+    configs.swap(expanded);
+  }
+}
+
+static bool sameKnobs(const AampAbrConfig& a, const AampAbrConfig& b) {
+  for (int k = 0; k < KNOB_COUNT; k++) {
+    if (a.*(KNOBS[k].field) != b.*(KNOBS[k].field)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void buildRandom(const std::vector<KnobSpec>& specs, int count, unsigned seed, std::vector<AampAbrConfig>& configs) {
+  configs.clear();
+  for (int c = 0; c < count; c++) {
+    AampAbrConfig config = DEFAULT_CONFIG;
+    for (size_t s = 0; s < specs.size(); s++) {
+      const KnobSpec& spec = specs[s];
+      int value;
+      if (spec.isRange) {
+        value = spec.minValue + (int)(rand_r(&seed) % ((unsigned)(spec.maxValue - spec.minValue) + 1));
+      } else {
+        value = spec.values[rand_r(&seed) % spec.values.size()];
+      }
+      config.*(KNOBS[spec.knob].field) = value;
+    }
+    bool duplicate = false;
+    for (size_t i = 0; i < configs.size() && !duplicate; i++) {
+      duplicate = sameKnobs(configs[i], config);
+    }
+    if (!duplicate) {
+      configs.push_back(config);
+    }
+  }
+}
+
+/**
+ * @brief a dominates b: not worse on QoE, bitrate and rebuffer, better on one
+ */
+static bool dominates(const Result& a, const Result& b) {
+  bool notWorse = a.qoe >= b.qoe && a.bitrate >= b.bitrate && a.rebufferRatio <= b.rebufferRatio;
+  bool better = a.qoe > b.qoe || a.bitrate > b.bitrate || a.rebufferRatio < b.rebufferRatio;
+  return notWorse && better;
+}
+
+static void printResult(const Result& result, const AampAbrConfig& config) {
+  printf("%8.3f %10.0f %8.3f %7.1f", result.qoe, result.bitrate, result.rebufferRatio * 100, result.switches);
+  for (int k = 0; k < KNOB_COUNT; k++) {
+    printf(" %s=%d", KNOBS[k].name, config.*(KNOBS[k].field));
+  }
+  printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+  int threadCount = (int)std::thread::hardware_concurrency();
+  int randomCount = 0;
+  unsigned seed = 1;
+  bool printAll = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "j:r:s:a")) != -1) {
+    switch (opt) {
+      case 'j': threadCount = atoi(optarg); break;
+      case 'r': randomCount = atoi(optarg); break;
+      case 's': seed = (unsigned)strtoul(optarg, NULL, 10); break;
+      case 'a': printAll = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-j threads] [-r count] [-s seed] [-a] <spec> <trace>...\n", argv[0]);
+        return 1;
+    }
+  }
+  if (argc - optind < 2) {
+    fprintf(stderr, "Usage: %s [-j threads] [-r count] [-s seed] [-a] <spec> <trace>...\n", argv[0]);
+    return 1;
+  }
+  threadCount = std::max(threadCount, 1);
+
+  std::vector<KnobSpec> specs;
+  if (!readSpec(argv[optind], specs)) {
+    return 1;
+  }
+  std::vector<Trace> traces;
+  for (int i = optind + 1; i < argc; i++) {
+    Trace trace;
+    if (!readTrace(argv[i], trace)) {
+      return 1;
+    }
+    traces.push_back(trace);
+  }
+
+  std::vector<AampAbrConfig> configs;
+  if (randomCount > 0) {
+    buildRandom(specs, randomCount, seed, configs);
+  } else {
+    for (size_t s = 0; s < specs.size(); s++) {
+      if (specs[s].isRange) {
+        fprintf(stderr, "Range of %s needs a random search (-r)\n", KNOBS[specs[s].knob].name);
+        return 1;
+      }
+    }
+    buildGrid(specs, configs);
+  }
+
+  ABRManager::disableLogger();
+  ABRManager::logprintf = quietLogger;
+
+  int traceCount = static_cast<int>(traces.size());
+  std::vector<Result> results(configs.size() * traces.size());
+  SweepJob job = { &configs, &traces, &results };
+  WorkStealingPool::run(static_cast<int>(results.size()), threadCount, job);
+
+  std::vector<Result> means(configs.size());
+  for (size_t c = 0; c < configs.size(); c++) {
+    Result mean = { 0, 0, 0, 0 };
+    for (int t = 0; t < traceCount; t++) {
+      const Result& r = results[c * traceCount + t];
+      mean.qoe += r.qoe / traceCount;
+      mean.bitrate += r.bitrate / traceCount;
+      mean.rebufferRatio += r.rebufferRatio / traceCount;
+      mean.switches += r.switches / traceCount;
+    }
+    means[c] = mean;
+  }
+
+  std::vector<int> shown;
+  for (size_t c = 0; c < configs.size(); c++) {
+    bool dominated = false;
+    for (size_t o = 0; o < configs.size() && !dominated && !printAll; o++) {
+      dominated = dominates(means[o], means[c]);
+    }
+    if (!dominated) {
+      shown.push_back((int)c);
+    }
+  }
+  std::sort(shown.begin(), shown.end(), [&means](int a, int b) { return means[a].qoe > means[b].qoe; });
+
+  printf("# %zu configurations x %zu traces on %d threads, %s\n", configs.size(), traces.size(), threadCount,
+    printAll ? "all configurations" : "Pareto front");
+  printf("#    QoE/s    bitrate rebuf%% switches config\n");
+  for (size_t i = 0; i < shown.size(); i++) {
+    printResult(means[shown[i]], configs[shown[i]]);
+  }
+  return 0;
+}